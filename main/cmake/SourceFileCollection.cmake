@@ -4,6 +4,9 @@
 set(COMMON_SOURCES
     src/common/json_reader.cpp
     src/common/file_reader.cpp
+    src/common/input_file.cpp
+    src/common/mapped_file.cpp
+    src/common/symbol_table.cpp
 )
 
 # --- CLI 模块 ---
@@ -11,15 +14,24 @@ set(CLI_SOURCES
     src/cli/framework/application.cpp
 )
 
+# --- Config 模块 ---
+set(CONFIG_SOURCES
+    src/infrastructure/config/embedded_mapping.cpp
+)
+
 # --- Validator 模块 ---
 set(VALIDATOR_SOURCES
     src/infrastructure/validation/validator.cpp
+    src/infrastructure/validation/diagnostic.cpp
     src/infrastructure/validation/internal/line_validator.cpp
+    src/infrastructure/validation/internal/title_matcher.cpp
+    src/infrastructure/validation/internal/title_suggester.cpp
 )
 
 # --- Converter 模块 ---
 set(CONVERTER_SOURCES
     src/infrastructure/converter/converter.cpp
+    src/infrastructure/converter/line_index.cpp
     src/infrastructure/converter/log_parser.cpp
     src/infrastructure/converter/project_name_mapper.cpp
 )
@@ -39,6 +51,7 @@ set(SERIALIZER_SOURCES
 set(CONTROLLER_SOURCES
     src/application/action_handler.cpp
     src/application/file_processor_handler.cpp
+    src/application/mapping_cache.cpp
     src/application/database_handler.cpp
 )
 
@@ -48,6 +61,8 @@ set(DB_SOURCES
     src/infrastructure/persistence/facade/query_facade.cpp
     src/infrastructure/persistence/manager/db_manager.cpp
     src/infrastructure/persistence/inserter/data_inserter.cpp
+    src/infrastructure/persistence/checkpoint/checkpoint_store.cpp
+    src/infrastructure/persistence/mapping/exercise_mapping_store.cpp
 )
 
 # --- Report 模块 ---
@@ -61,6 +76,7 @@ set(REPORT_SOURCES
 set(ALL_SOURCES
     ${COMMON_SOURCES}
     ${CLI_SOURCES}
+    ${CONFIG_SOURCES}
     ${VALIDATOR_SOURCES}
     ${CONVERTER_SOURCES}
     ${DOMAIN_SERVICES_SOURCES}
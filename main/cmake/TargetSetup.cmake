@@ -29,36 +29,75 @@ function(setup_compiler_flags)
 endfunction()
 
 # --- 2. 定义核心构建函数 ---
+# 除入口文件外的全部源文件编译为静态库 ${TARGET_NAME}_core,
+# 可执行文件与 tests/ 下的测试共同链接它
 function(configure_workout_target TARGET_NAME ENTRY_POINT_FILE SOURCE_LIST)
-    # 创建可执行文件
-    add_executable(
-        ${TARGET_NAME}
-        ${ENTRY_POINT_FILE}
-        ${SOURCE_LIST}
-    )
+    set(CORE_TARGET ${TARGET_NAME}_core)
+    add_library(${CORE_TARGET} STATIC ${SOURCE_LIST})
 
     # 设置头文件包含路径
     target_include_directories(
-        ${TARGET_NAME}
-        PRIVATE
+        ${CORE_TARGET}
+        PUBLIC
         ${CMAKE_CURRENT_SOURCE_DIR}/src
     )
 
+    # --- 内嵌默认映射 ---
+    # 构建时把 config/mapping.json 编译为常量表 (embedded_mapping_data.inc)，
+    # 由 src/infrastructure/config/embedded_mapping.hpp 生成完美哈希
+    set(MAPPING_FILE_SOURCE ${CMAKE_CURRENT_SOURCE_DIR}/config/mapping.json)
+    set(GENERATED_DIR ${PROJECT_BINARY_DIR}/generated)
+    set(EMBEDDED_MAPPING_DATA ${GENERATED_DIR}/embedded_mapping_data.inc)
+
+    add_executable(embed_mapping src/tools/embed_mapping.cpp)
+    target_link_libraries(embed_mapping PRIVATE cjson)
+    # 生成工具不放进 bin/
+    set_target_properties(embed_mapping PROPERTIES
+        RUNTIME_OUTPUT_DIRECTORY ${PROJECT_BINARY_DIR}/tools)
+
+    add_custom_command(
+        OUTPUT ${EMBEDDED_MAPPING_DATA}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${GENERATED_DIR}
+        COMMAND embed_mapping ${MAPPING_FILE_SOURCE} ${EMBEDDED_MAPPING_DATA}
+        DEPENDS embed_mapping ${MAPPING_FILE_SOURCE}
+        COMMENT "Embedding config/mapping.json into ${TARGET_NAME}"
+    )
+    target_sources(${CORE_TARGET} PRIVATE ${EMBEDDED_MAPPING_DATA})
+    target_include_directories(${CORE_TARGET} PRIVATE ${GENERATED_DIR})
+    # 完美哈希在编译期构建；放宽常量求值步数，以容纳较大的映射文件
+    set_source_files_properties(
+        src/infrastructure/config/embedded_mapping.cpp
+        PROPERTIES COMPILE_OPTIONS
+        "$<$<CXX_COMPILER_ID:GNU>:-fconstexpr-ops-limit=1073741824>;$<$<CXX_COMPILER_ID:Clang>:-fconstexpr-steps=1073741824>"
+    )
+
     # 预编译头文件
     target_precompile_headers(
-        ${TARGET_NAME}
+        ${CORE_TARGET}
         PRIVATE
         src/pch.hpp
     )
 
     # 链接第三方库
     target_link_libraries(
-        ${TARGET_NAME}
-        PRIVATE
+        ${CORE_TARGET}
+        PUBLIC
         cjson
         SQLite::SQLite3
+        Threads::Threads
     )
 
+    if(ZLIB_FOUND)
+        target_link_libraries(${CORE_TARGET} PUBLIC ZLIB::ZLIB)
+        target_compile_definitions(${CORE_TARGET} PUBLIC WORKOUT_HAVE_ZLIB)
+    else()
+        message(STATUS "zlib not found: .gz input will be rejected")
+    endif()
+
+    # 创建可执行文件
+    add_executable(${TARGET_NAME} ${ENTRY_POINT_FILE})
+    target_link_libraries(${TARGET_NAME} PRIVATE ${CORE_TARGET})
+
     # --- 复制配置文件逻辑 (已修改) ---
     # [MODIFIED] 源路径改为根目录下的 config/mapping.json，不再从 src/config 查找
     set(CONFIG_FILE_SOURCE ${CMAKE_CURRENT_SOURCE_DIR}/config/mapping.json)
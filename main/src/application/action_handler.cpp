@@ -4,6 +4,7 @@
 
 #include "application/database_handler.hpp"
 #include "application/file_processor_handler.hpp"
+#include "application/mapping_cache.hpp"
 #include "infrastructure/config/file_mapping_provider.hpp"
 #include "infrastructure/converter/log_parser.hpp"
 
@@ -30,15 +31,35 @@ auto ActionHandler::Run(const AppConfig& config) -> AppExitCode {
     FileMappingProvider mapping_provider;
     FileProcessorHandler file_processor(parser, mapping_provider);
 
-    auto data_opt =
-        file_processor.ProcessFile({.file_path_ = config.log_filepath_,
+    auto validation_opt =
+        file_processor.PrepareFile({.file_path_ = config.log_filepath_,
                                     .mapping_path_ = config.mapping_path_});
-    if (data_opt.has_value()) {
-      // Direct insertion of native C++ structs into the database
-      // to avoid unnecessary JSON conversion overhead.
-      return DatabaseHandler::InsertData(data_opt.value(), config);
+    if (!validation_opt.has_value()) {
+      return AppExitCode::kProcessingError;
     }
-    return AppExitCode::kProcessingError;
+
+    // Days are validated, converted and inserted one at a time, straight
+    // from the parser into the database, so memory stays flat however large
+    // the log. A validation error anywhere rolls the whole file back. Logs
+    // are append-only: a file ingested before is only read from the
+    // checkpoint of the previous run on.
+    return DatabaseHandler::InsertDataIncremental(
+        config.log_filepath_,
+        [&](StreamResume& resume, const DaySink& sink) -> bool {
+          return file_processor.ConvertFileStreaming(
+              config.log_filepath_, validation_opt.value(), sink, resume);
+        },
+        config);
+  }
+
+  if (config.action_ == ActionType::Remap) {
+    FileMappingProvider mapping_provider;
+    MappingCache mapping_cache(mapping_provider);
+    const auto kMapping = mapping_cache.Get(config.mapping_path_);
+    if (kMapping == nullptr) {
+      return AppExitCode::kProcessingError;
+    }
+    return DatabaseHandler::RemapExercises(*kMapping->mapper_, config);
   }
 
   return AppExitCode::kUnknownError;
@@ -7,7 +7,7 @@
 
 #include "application/exit_code.hpp"
 
-enum class ActionType { Validate, Convert, Insert, Export, Ingest, QueryPR, ListExercises, QueryCycles, QueryVolume };
+enum class ActionType { Validate, Convert, Insert, Export, Ingest, QueryPR, ListExercises, QueryCycles, QueryVolume, Remap };
 
 struct AppConfig {
   ActionType action_;
@@ -16,6 +16,17 @@ struct AppConfig {
   std::string base_path_;
   std::string type_filter_;
   std::string cycle_id_filter_;
+  // convert: write the JSON to stdout instead of output/data. Implied when
+  // the log is read from stdin. validate: print a JSON report on stdout;
+  // everything else goes to stderr.
+  bool json_to_stdout_ = false;
+  // validate: how many files are checked at once; 0 means one per hardware
+  // thread.
+  unsigned jobs_ = 1;
+  // validate: stop checking a file after this many errors; 0 means no limit.
+  unsigned max_errors_ = 0;
+  // validate: stop at the first error, leaving the remaining files unchecked.
+  bool fail_fast_ = false;
 };
 
 class ActionHandler {
@@ -2,14 +2,19 @@
 
 #include "application/database_handler.hpp"
 
+#include <chrono>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <optional>
+#include <system_error>
 #include <utility>
 #include <vector>
 
 #include "common/file_reader.hpp"
+#include "common/input_file.hpp"
 #include "common/json_reader.hpp"
+#include "domain/services/date_service.hpp"
 #include "infrastructure/persistence/facade/db_facade.hpp"
 #include "infrastructure/persistence/facade/query_facade.hpp"
 #include "infrastructure/persistence/manager/db_manager.hpp"
@@ -121,7 +126,7 @@ auto DatabaseHandler::Handle(const AppConfig& config) -> AppExitCode {
       std::cout << "\n--- Personal Records ---" << std::endl;
       for (const auto& pr : prs) {
         std::cout << pr.exercise_name << ": " << pr.max_weight << "kg x "
-                  << pr.reps << " (Date: " << pr.date << ")";
+                  << pr.reps << " (Date: " << DateService::Format(pr.date) << ")";
         if (pr.reps > 1) {
           std::cout << " [Est. 1RM: Epley " << std::fixed
                     << std::setprecision(1) << pr.estimated_1rm_epley
@@ -158,18 +163,27 @@ auto DatabaseHandler::Handle(const AppConfig& config) -> AppExitCode {
       }
       std::cout << "\n--- Training Cycles ---" << std::endl;
       for (const auto& cycle : cycles) {
-        std::cout << "Cycle: " << cycle.cycle_id << " [" << cycle.type << "] "
+        std::cout << "Cycle: " << DateService::Format(cycle.cycle_id) << " ["
+                  << cycle.type << "] "
                   << "Duration: " << cycle.total_days << " days ("
-                  << cycle.start_date << " to " << cycle.end_date << ")"
+                  << DateService::Format(cycle.start_date) << " to "
+                  << DateService::Format(cycle.end_date) << ")"
                   << std::endl;
       }
       return AppExitCode::kSuccess;
     }
 
     if (config.action_ == ActionType::QueryVolume) {
-      auto stats_opt = QueryFacade::GetVolumeStats(db_manager.GetConnection(),
-                                                   config.cycle_id_filter_,
-                                                   config.type_filter_);
+      // Cycles are identified by their first date
+      const std::optional<std::chrono::sys_days> kCycleId =
+          DateService::Parse(config.cycle_id_filter_);
+      if (!kCycleId.has_value()) {
+        std::cerr << "Error: --cycle must be a date in YYYY-MM-DD format, got '"
+                  << config.cycle_id_filter_ << "'." << std::endl;
+        return AppExitCode::kInvalidArgs;
+      }
+      auto stats_opt = QueryFacade::GetVolumeStats(
+          db_manager.GetConnection(), kCycleId.value(), config.type_filter_);
 
       if (!stats_opt.has_value()) {
         std::cout << "No data found for Cycle: " << config.cycle_id_filter_
@@ -196,7 +210,8 @@ auto DatabaseHandler::Handle(const AppConfig& config) -> AppExitCode {
       };
 
       std::cout << "\n--- Advanced Kinematics Analysis ---" << std::endl;
-      std::cout << "Cycle:           " << stats.cycle_id << std::endl;
+      std::cout << "Cycle:           " << DateService::Format(stats.cycle_id)
+                << std::endl;
       std::cout << "Type:            " << stats.exercise_type << std::endl;
       std::cout << "------------------------------------" << std::endl;
       std::cout << "Total Volume:    " << std::fixed << std::setprecision(1)
@@ -226,7 +241,7 @@ auto DatabaseHandler::Handle(const AppConfig& config) -> AppExitCode {
   return AppExitCode::kUnknownError;
 }
 
-auto DatabaseHandler::InsertData(const std::vector<DailyData>& data,
+auto DatabaseHandler::InsertData(const WorkoutLog& data,
                                  const AppConfig& config) -> AppExitCode {
   std::cout << "Performing database insertion..." << std::endl;
 
@@ -247,4 +262,92 @@ auto DatabaseHandler::InsertData(const std::vector<DailyData>& data,
 
   std::cerr << "Failed to insert data." << std::endl;
   return AppExitCode::kDatabaseError;
-}
\ No newline at end of file
+}
+
+auto DatabaseHandler::InsertDataIncremental(
+    const std::string& source,
+    const std::function<bool(StreamResume&, const DaySink&)>& produce_days,
+    const AppConfig& config) -> AppExitCode {
+  std::cout << "Performing database insertion..." << std::endl;
+
+  fs::path db_dir = fs::path(config.base_path_) / "output" / "db";
+  fs::create_directories(db_dir);
+  fs::path db_path = db_dir / "workout_logs.sqlite3";
+  DbManager db_manager(db_path.string());
+
+  if (!db_manager.Open()) {
+    std::cerr << "Failed to open database." << std::endl;
+    return AppExitCode::kDatabaseError;
+  }
+
+  // The same file reached through another relative path or a symlink
+  // shares its checkpoint. Input from stdin has no identity across runs, so
+  // it gets none and is always stored as a new cycle.
+  fs::path source_key;
+  if (!InputFile::IsStdin(source)) {
+    std::error_code error;
+    source_key = fs::weakly_canonical(fs::absolute(source), error);
+    if (error) {
+      source_key = fs::absolute(source);
+    }
+  }
+
+  bool produced = true;
+  if (DbFacade::InsertTrainingDataIncremental(
+          db_manager.GetConnection(), source_key.string(),
+          [&](StreamResume& resume, const DaySink& sink) -> bool {
+            produced = produce_days(resume, sink);
+            return produced;
+          })) {
+    std::cout << "Successfully inserted data." << std::endl;
+    return AppExitCode::kSuccess;
+  }
+
+  // A failing producer has reported its own error; the insert was rolled back.
+  if (!produced) {
+    return AppExitCode::kProcessingError;
+  }
+  std::cerr << "Failed to insert data." << std::endl;
+  return AppExitCode::kDatabaseError;
+}
+
+auto DatabaseHandler::RemapExercises(const ProjectNameMapper& mapper,
+                                     const AppConfig& config) -> AppExitCode {
+  std::cout << "Remapping exercises in the database..." << std::endl;
+
+  fs::path db_path =
+      fs::path(config.base_path_) / "output" / "db" / "workout_logs.sqlite3";
+  if (!fs::exists(db_path)) {
+    std::cerr << "Error: Database file not found at " << db_path.string()
+              << std::endl;
+    return AppExitCode::kFileNotFound;
+  }
+
+  DbManager db_manager(db_path.string());
+  if (!db_manager.Open()) {
+    return AppExitCode::kDatabaseError;
+  }
+
+  const std::optional<RemapSummary> kSummary =
+      DbFacade::RemapExercises(db_manager.GetConnection(), mapper);
+  if (!kSummary.has_value()) {
+    std::cerr << "Failed to remap exercises." << std::endl;
+    return AppExitCode::kDatabaseError;
+  }
+
+  std::cout << "Stored " << kSummary->mapping_count_ << " mappings; "
+            << kSummary->updated_logs_ << " log rows updated." << std::endl;
+  if (kSummary->backfilled_logs_ > 0) {
+    std::cout << "Recorded the exercise code of "
+              << kSummary->backfilled_logs_ << " older log rows." << std::endl;
+  }
+  if (kSummary->uncoded_logs_ > 0) {
+    std::cout << "Warning: " << kSummary->uncoded_logs_
+              << " log rows were stored before exercise codes were recorded "
+                 "and their names match no single mapping; they were left "
+                 "unchanged. Rebuilding the database from the logs records "
+                 "their codes."
+              << std::endl;
+  }
+  return AppExitCode::kSuccess;
+}
@@ -3,15 +3,32 @@
 #ifndef APPLICATION_DATABASE_HANDLER_HPP_
 #define APPLICATION_DATABASE_HANDLER_HPP_
 #include "application/action_handler.hpp"
-#include "domain/models/workout_item.hpp"
+#include "domain/models/parse_checkpoint.hpp"
+#include "domain/models/workout_log.hpp"
+#include "infrastructure/converter/project_name_mapper.hpp"
+#include <functional>
+#include <string>
 #include <vector>
 
 // 这个类专门处理与数据库相关的所有操作。
 class DatabaseHandler {
 public:
   [[nodiscard]] static auto Handle(const AppConfig& config) -> AppExitCode;
-  [[nodiscard]] static auto InsertData(const std::vector<DailyData>& data,
+  [[nodiscard]] static auto InsertData(const WorkoutLog& data,
                                        const AppConfig& config) -> AppExitCode;
+  // Inserts the days `produce_days` emits for the append-only log at
+  // `source`, inside one transaction, resuming after the days an earlier
+  // run stored. A log read from stdin never resumes. If the producer fails,
+  // nothing is kept and kProcessingError is returned.
+  [[nodiscard]] static auto InsertDataIncremental(
+      const std::string& source,
+      const std::function<bool(StreamResume&, const DaySink&)>& produce_days,
+      const AppConfig& config) -> AppExitCode;
+  // Rewrites the exercise names and types of the stored logs from `mapper`
+  // (see DbFacade::RemapExercises), so a mapping change needs no re-ingest.
+  [[nodiscard]] static auto RemapExercises(const ProjectNameMapper& mapper,
+                                           const AppConfig& config)
+      -> AppExitCode;
 };
 
 #endif // APPLICATION_DATABASE_HANDLER_HPP_
\ No newline at end of file
@@ -3,40 +3,111 @@
 #include "application/file_processor_handler.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "common/c_json_helper.hpp"
 #include "common/file_reader.hpp"
+#include "common/input_file.hpp"
 #include "infrastructure/serializer/serializer.hpp"
 #include "infrastructure/validation/validator.hpp"
 
 namespace fs = std::filesystem;
 
-FileProcessorHandler::FileProcessorHandler(ILogParser& parser,
+namespace {
+
+auto PrintFileHeader(const std::string& file_path) -> void {
+  std::cout << "===== File: " << file_path << " =====" << std::endl;
+}
+
+auto PrintFileFooter() -> void {
+  std::cout << "====================================\n" << std::endl;
+}
+
+auto PrintValidationOutcome(AppExitCode result) -> void {
+  if (result == AppExitCode::kSuccess) {
+    std::cout << "Validation successful." << std::endl;
+  } else if (result == AppExitCode::kValidationError) {
+    std::cerr << "Validation failed." << std::endl;
+  }
+}
+
+auto ValidationStatus(AppExitCode result) -> const char* {
+  switch (result) {
+    case AppExitCode::kSuccess:
+      return "passed";
+    case AppExitCode::kValidationError:
+      return "failed";
+    default:
+      return "unreadable";
+  }
+}
+
+}  // namespace
+
+FileProcessorHandler::FileProcessorHandler(const ILogParser& parser,
                                            IMappingProvider& mapping_provider)
-    : converter_(parser, mapping_provider), validator_(mapping_provider) {}
+    : converter_(parser), mapping_cache_(mapping_provider) {}
 
 auto FileProcessorHandler::Handle(const AppConfig& config) -> AppExitCode {
-  if (!converter_.Configure(config.mapping_path_)) {
+  if (!config.json_to_stdout_) {
+    return ProcessFiles(config);
+  }
+
+  // stdout carries nothing but the JSON; status messages go to stderr.
+  std::ostream json_out(std::cout.rdbuf());
+  std::streambuf* const kStdout = std::cout.rdbuf(std::cerr.rdbuf());
+  json_out_ = &json_out;
+  const AppExitCode kResult = ProcessFiles(config);
+  json_out_ = nullptr;
+  std::cout.rdbuf(kStdout);
+  return kResult;
+}
+
+auto FileProcessorHandler::ProcessFiles(const AppConfig& config)
+    -> AppExitCode {
+  // Loaded once here; every file below reuses the snapshot unless the
+  // mapping file changes in the meantime.
+  if (mapping_cache_.Get(config.mapping_path_) == nullptr) {
     return AppExitCode::kProcessingError;
   }
 
   std::vector<std::string> files_to_process =
-      FileReader::FindFilesByExtension(config.log_filepath_, ".txt");
+      InputFile::IsStdin(config.log_filepath_)
+          ? std::vector<std::string>{config.log_filepath_}
+          : FileReader::FindFilesByExtension(config.log_filepath_, ".txt");
   if (files_to_process.empty()) {
     std::cout << "Warning: No .txt files found to process." << std::endl;
     return AppExitCode::kSuccess;
   }
 
+  std::vector<AppExitCode> results;
+  if (config.action_ == ActionType::Validate) {
+    results = ValidateFiles(files_to_process, config);
+  } else {
+    for (const auto& file_path : files_to_process) {
+      results.push_back(ProcessSingleFile(file_path, config));
+    }
+  }
+  if (results.size() < files_to_process.size()) {
+    std::cout << "Stopped at the first failure; "
+              << files_to_process.size() - results.size()
+              << " files were not checked." << std::endl;
+  }
+
   int success_count = 0;
   AppExitCode last_error = AppExitCode::kSuccess;
 
-  for (const auto& file_path : files_to_process) {
-    AppExitCode result = ProcessSingleFile(file_path, config);
+  for (const AppExitCode result : results) {
     if (result == AppExitCode::kSuccess) {
       success_count++;
     } else {
@@ -55,39 +126,30 @@ auto FileProcessorHandler::Handle(const AppConfig& config) -> AppExitCode {
 
 auto FileProcessorHandler::ProcessSingleFile(const std::string& file_path,
                                              const AppConfig& config) -> AppExitCode {
-  std::cout << "===== File: " << file_path << " =====" << std::endl;
+  PrintFileHeader(file_path);
   AppExitCode result = AppExitCode::kUnknownError;
 
-  if (config.action_ == ActionType::Validate) {
-    std::cout << "Performing validation..." << std::endl;
-    std::ifstream file(file_path);
-    if (file.is_open()) {
-      if (validator_.Validate(file, config.mapping_path_)) {
-        std::cout << "Validation successful." << std::endl;
-        result = AppExitCode::kSuccess;
-      } else {
-        std::cerr << "Validation failed." << std::endl;
-        result = AppExitCode::kValidationError;
-      }
-    } else {
-      std::cerr << "Error: Failed to open file for validation: " << file_path << std::endl;
-      result = AppExitCode::kFileNotFound;
-    }
-  } else if (config.action_ == ActionType::Convert) {
+  if (config.action_ == ActionType::Convert) {
     std::cout << "Performing conversion..." << std::endl;
-    std::ifstream val_file(file_path);
-    if (!val_file.is_open()) {
-        std::cerr << "Error: Failed to open file: " << file_path << std::endl;
-        result = AppExitCode::kFileNotFound;
-    } else if (!validator_.Validate(val_file, config.mapping_path_)) {
+    // The file is validated while it is converted, in a single read.
+    std::error_code error;
+    if (json_out_ != nullptr) {
+      result = ConvertToStream(file_path, config, *json_out_);
+    } else if (!fs::is_regular_file(file_path, error)) {
+      std::cerr << "Error: Failed to open file: " << file_path << std::endl;
+      result = AppExitCode::kFileNotFound;
+    } else if (auto validation_opt = BeginPass(config.mapping_path_);
+               !validation_opt.has_value()) {
+      std::cerr << "Validation failed, skipping conversion." << std::endl;
+      result = AppExitCode::kValidationError;
+    } else if (auto processed_data_opt =
+                   converter_.Convert(file_path, validation_opt.value());
+               !validation_opt->Passed()) {
       std::cerr << "Validation failed, skipping conversion." << std::endl;
       result = AppExitCode::kValidationError;
     } else {
-      val_file.close();
-      auto processed_data_opt = converter_.Convert(file_path);
-
       if (processed_data_opt.has_value() &&
-          !processed_data_opt.value().empty()) {
+          !processed_data_opt.value().Days().empty()) {
         try {
           const std::string kOutputDirBase = "output/data";
           fs::path reprocessed_base_path =
@@ -96,7 +158,8 @@ auto FileProcessorHandler::ProcessSingleFile(const std::string& file_path,
           fs::create_directories(reprocessed_base_path);
 
           std::string base_filename =
-              fs::path(file_path).stem().string() + ".json";
+              InputFile::WithoutCompression(file_path).stem().string() +
+              ".json";
           fs::path output_filepath = reprocessed_base_path / base_filename;
 
           std::string output_content =
@@ -128,10 +191,204 @@ auto FileProcessorHandler::ProcessSingleFile(const std::string& file_path,
     }
   }
 
-  std::cout << "====================================\n" << std::endl;
+  PrintFileFooter();
   return result;
 }
 
+auto FileProcessorHandler::ValidateFiles(
+    const std::vector<std::string>& file_paths, const AppConfig& config)
+    -> std::vector<AppExitCode> {
+  // Diagnostics are collected per file and printed with the file's block,
+  // never straight from the validator.
+  const ValidationOptions kOptions{
+      .max_errors_ = config.fail_fast_ ? 1 : config.max_errors_,
+      .text_output_ = nullptr};
+
+  CJsonPtr json_report =
+      json_out_ != nullptr ? MakeCJson(cJSON_CreateObject()) : nullptr;
+  cJSON* json_files = json_report != nullptr
+                          ? cJSON_AddArrayToObject(json_report.get(), "files")
+                          : nullptr;
+
+  std::vector<AppExitCode> results;
+  results.reserve(file_paths.size());
+  auto report_file = [&](size_t index,
+                         const FileValidation& validation) -> bool {
+    PrintFileValidation(file_paths[index], validation);
+    if (json_files != nullptr) {
+      cJSON* json_file = cJSON_CreateObject();
+      cJSON_AddStringToObject(json_file, "path", file_paths[index].c_str());
+      cJSON_AddStringToObject(json_file, "status",
+                              ValidationStatus(validation.result_));
+      AddValidationReportToJson(json_file, validation.report_);
+      if (!validation.read_errors_.empty()) {
+        std::string read_error = validation.read_errors_;
+        read_error.pop_back();  // the trailing newline
+        cJSON_AddStringToObject(json_file, "read_error", read_error.c_str());
+      }
+      cJSON_AddItemToArray(json_files, json_file);
+    }
+    results.push_back(validation.result_);
+    return !config.fail_fast_ || validation.result_ == AppExitCode::kSuccess;
+  };
+
+  const unsigned kJobs =
+      config.jobs_ != 0 ? config.jobs_ : std::thread::hardware_concurrency();
+  if (kJobs > 1 && file_paths.size() > 1) {
+    ValidateFilesParallel(file_paths, config.mapping_path_, kOptions, kJobs,
+                          report_file);
+  } else {
+    for (size_t index = 0; index < file_paths.size(); ++index) {
+      if (!report_file(index, ValidateFile(file_paths[index],
+                                           config.mapping_path_, kOptions))) {
+        break;
+      }
+    }
+  }
+
+  if (json_report != nullptr) {
+    const auto kPassed = static_cast<double>(
+        std::count(results.begin(), results.end(), AppExitCode::kSuccess));
+    cJSON_AddNumberToObject(json_report.get(), "files_total",
+                            static_cast<double>(file_paths.size()));
+    cJSON_AddNumberToObject(json_report.get(), "files_checked",
+                            static_cast<double>(results.size()));
+    cJSON_AddNumberToObject(json_report.get(), "files_passed", kPassed);
+    char* json_string = cJSON_Print(json_report.get());
+    *json_out_ << json_string << std::endl;
+    cJSON_free(json_string);
+  }
+  return results;
+}
+
+auto FileProcessorHandler::ValidateFilesParallel(
+    const std::vector<std::string>& file_paths, const std::string& mapping_path,
+    const ValidationOptions& options, unsigned jobs,
+    const FileValidationSink& sink) -> void {
+  struct FileReport {
+    FileValidation validation_;
+    bool done_ = false;
+  };
+  std::vector<FileReport> reports(file_paths.size());
+  std::mutex mutex;
+  std::condition_variable report_done;
+  std::atomic<size_t> next_file{0};
+  // Set once the sink stops the run; workers then pick up no new files.
+  std::atomic<bool> stopped{false};
+
+  auto validate_files = [&]() -> void {
+    for (size_t index = next_file++; index < file_paths.size() && !stopped;
+         index = next_file++) {
+      FileValidation validation =
+          ValidateFile(file_paths[index], mapping_path, options);
+      {
+        const std::lock_guard<std::mutex> kLock(mutex);
+        reports[index] = {.validation_ = std::move(validation), .done_ = true};
+      }
+      report_done.notify_all();
+    }
+  };
+
+  std::vector<std::jthread> workers;
+  const size_t kWorkers = std::min<size_t>(jobs, file_paths.size());
+  workers.reserve(kWorkers);
+  for (size_t worker = 0; worker < kWorkers; ++worker) {
+    workers.emplace_back(validate_files);
+  }
+
+  // Files are reported in order while later ones are still being checked.
+  for (size_t index = 0; index < file_paths.size(); ++index) {
+    FileReport report;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      report_done.wait(lock,
+                       [&]() -> bool { return reports[index].done_; });
+      report = std::move(reports[index]);
+    }
+    if (!sink(index, report.validation_)) {
+      stopped = true;
+      break;
+    }
+  }
+}
+
+auto FileProcessorHandler::ValidateFile(const std::string& file_path,
+                                        const std::string& mapping_path,
+                                        const ValidationOptions& options)
+    -> FileValidation {
+  FileValidation validation;
+  std::ostringstream read_errors;
+  InputFile file(read_errors);
+  if (!file.Open(file_path)) {
+    read_errors << "Error: Failed to open file for validation: " << file_path
+                << '\n';
+    validation.result_ = AppExitCode::kFileNotFound;
+  } else if (const auto kMapping = mapping_cache_.Get(mapping_path);
+             kMapping == nullptr) {
+    validation.result_ = AppExitCode::kValidationError;
+  } else {
+    validation.report_ =
+        Validator::Validate(file.Stream(), kMapping->rules_, options);
+    validation.result_ = validation.report_.Passed() && !file.Failed()
+                             ? AppExitCode::kSuccess
+                             : AppExitCode::kValidationError;
+  }
+  validation.read_errors_ = std::move(read_errors).str();
+  return validation;
+}
+
+auto FileProcessorHandler::PrintFileValidation(
+    const std::string& file_path, const FileValidation& validation) -> void {
+  PrintFileHeader(file_path);
+  std::cout << "Performing validation..." << std::endl;
+  std::cerr << validation.read_errors_ + FormatDiagnostics(validation.report_);
+  if (validation.report_.stopped_early_) {
+    std::cerr << "Error limit reached; the rest of the file was not checked.\n";
+  }
+  std::cerr.flush();
+  PrintValidationOutcome(validation.result_);
+  PrintFileFooter();
+}
+
+auto FileProcessorHandler::ConvertToStream(const std::string& file_path,
+                                           const AppConfig& config,
+                                           std::ostream& out) -> AppExitCode {
+  auto validation_opt = BeginPass(config.mapping_path_);
+  if (!validation_opt.has_value()) {
+    std::cerr << "Validation failed, skipping conversion." << std::endl;
+    return AppExitCode::kValidationError;
+  }
+
+  std::cout << "Writing converted data to stdout..." << std::endl;
+  StreamingSerializer writer(out);
+  StreamResume resume;
+  const bool kConverted = converter_.ConvertStreaming(
+      file_path,
+      [&](DailyData& daily, SymbolTable& symbols) -> bool {
+        writer.WriteDay(daily, symbols);
+        return static_cast<bool>(out);
+      },
+      validation_opt.value(), resume);
+  if (!validation_opt->Passed()) {
+    std::cerr << "Validation failed, output is incomplete." << std::endl;
+    return AppExitCode::kValidationError;
+  }
+  if (kConverted) {
+    writer.Finish();
+    out.flush();
+  }
+  if (!out) {
+    std::cerr << "Error writing to stdout." << std::endl;
+    return AppExitCode::kProcessingError;
+  }
+  if (!kConverted) {
+    std::cerr << "Conversion failed." << std::endl;
+    return AppExitCode::kProcessingError;
+  }
+  std::cout << "Conversion successful." << std::endl;
+  return AppExitCode::kSuccess;
+}
+
 auto FileProcessorHandler::WriteStringToFile(const std::string& file_path,
                                              const std::string& content)
     -> bool {
@@ -147,20 +404,50 @@ auto FileProcessorHandler::WriteStringToFile(const std::string& file_path,
 }
 
 auto FileProcessorHandler::ProcessFile(const FileProcessingOptions& options)
-    -> std::optional<std::vector<DailyData>> {
-  if (!converter_.Configure(options.mapping_path_)) {
+    -> std::optional<WorkoutLog> {
+  auto validation_opt = PrepareFile(options);
+  if (!validation_opt.has_value()) {
     return std::nullopt;
   }
 
-  std::cout << "Validating file: " << options.file_path_ << std::endl;
-  std::ifstream val_file(options.file_path_);
-  if (!val_file.is_open() ||
-      !validator_.Validate(val_file, options.mapping_path_)) {
+  std::cout << "Validating and converting file: " << options.file_path_
+            << std::endl;
+  auto processed_log_opt =
+      converter_.Convert(options.file_path_, validation_opt.value());
+  if (!validation_opt->Passed()) {
     std::cerr << "Validation failed for " << options.file_path_ << std::endl;
+  }
+  return processed_log_opt;
+}
+
+auto FileProcessorHandler::PrepareFile(const FileProcessingOptions& options)
+    -> std::optional<ValidationPass> {
+  auto validation_opt = BeginPass(options.mapping_path_);
+  if (!validation_opt.has_value()) {
+    std::cerr << "Validation failed for " << options.file_path_ << std::endl;
+  }
+  return validation_opt;
+}
+
+auto FileProcessorHandler::BeginPass(const std::string& mapping_path)
+    -> std::optional<ValidationPass> {
+  const auto kMapping = mapping_cache_.Get(mapping_path);
+  if (kMapping == nullptr) {
     return std::nullopt;
   }
-  val_file.close();
+  converter_.Configure(kMapping->mapper_);
+  return ValidationPass(kMapping->rules_);
+}
 
-  std::cout << "Converting file: " << options.file_path_ << std::endl;
-  return converter_.Convert(options.file_path_);
-}
\ No newline at end of file
+auto FileProcessorHandler::ConvertFileStreaming(const std::string& file_path,
+                                                ValidationPass& validation,
+                                                const DaySink& sink,
+                                                StreamResume& resume) -> bool {
+  std::cout << "Validating and converting file: " << file_path << std::endl;
+  const bool kConverted =
+      converter_.ConvertStreaming(file_path, sink, validation, resume);
+  if (!validation.Passed()) {
+    std::cerr << "Validation failed for " << file_path << std::endl;
+  }
+  return kConverted;
+}
@@ -6,8 +6,13 @@
 #include "application/action_handler.hpp"
 #include "application/interfaces/i_log_parser.hpp"
 #include "application/interfaces/i_mapping_provider.hpp"
+#include "application/mapping_cache.hpp"
 #include "infrastructure/converter/converter.hpp"
 #include "infrastructure/validation/validator.hpp"
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
 
 // 这个类专门处理与原始日志文件相关的所有操作。
 struct FileProcessingOptions {
@@ -17,20 +22,71 @@ struct FileProcessingOptions {
 
 class FileProcessorHandler {
 public:
-  FileProcessorHandler(ILogParser& parser, IMappingProvider& mapping_provider);
+  FileProcessorHandler(const ILogParser& parser,
+                       IMappingProvider& mapping_provider);
   
   [[nodiscard]] auto Handle(const AppConfig& config) -> AppExitCode;
   [[nodiscard]] auto ProcessFile(const FileProcessingOptions& options)
-      -> std::optional<std::vector<DailyData>>;
+      -> std::optional<WorkoutLog>;
+  // Loads the mapping and the validation rules; ProcessFile() runs this
+  // first. The returned pass is consumed by the conversion itself.
+  [[nodiscard]] auto PrepareFile(const FileProcessingOptions& options)
+      -> std::optional<ValidationPass>;
+  // Validates and converts a prepared file day by day into `sink` without
+  // keeping the whole log in memory, starting at resume.from_ if it is set.
+  [[nodiscard]] auto ConvertFileStreaming(const std::string& file_path,
+                                          ValidationPass& validation,
+                                          const DaySink& sink,
+                                          StreamResume& resume) -> bool;
 
 private:
   [[nodiscard]] static auto WriteStringToFile(const std::string& file_path,
                                               const std::string& content) -> bool;
   
+  [[nodiscard]] auto ProcessFiles(const AppConfig& config) -> AppExitCode;
   [[nodiscard]] auto ProcessSingleFile(const std::string& file_path, const AppConfig& config) -> AppExitCode;
 
+  struct FileValidation {
+    AppExitCode result_ = AppExitCode::kUnknownError;
+    ValidationReport report_;
+    // The file could not be opened or read to the end.
+    std::string read_errors_;
+  };
+  // Receives each file's result in file order; returns false to stop.
+  using FileValidationSink =
+      std::function<bool(size_t index, const FileValidation& validation)>;
+
+  // Validates the files in order, prints one block per file and, with
+  // --json, the report on stdout. Returns the results of the files checked.
+  [[nodiscard]] auto ValidateFiles(const std::vector<std::string>& file_paths,
+                                   const AppConfig& config)
+      -> std::vector<AppExitCode>;
+  // Checks `jobs` files at a time. Results are held back until every file
+  // before them is done, so `sink` sees them exactly as in a serial run.
+  auto ValidateFilesParallel(const std::vector<std::string>& file_paths,
+                             const std::string& mapping_path,
+                             const ValidationOptions& options, unsigned jobs,
+                             const FileValidationSink& sink) -> void;
+  // Validates one file. Safe to call from several threads.
+  [[nodiscard]] auto ValidateFile(const std::string& file_path,
+                                  const std::string& mapping_path,
+                                  const ValidationOptions& options)
+      -> FileValidation;
+  static auto PrintFileValidation(const std::string& file_path,
+                                  const FileValidation& validation) -> void;
+  // Converts day by day and writes each day to `out` as soon as it is
+  // complete. A validation error cuts the output short.
+  [[nodiscard]] auto ConvertToStream(const std::string& file_path, const AppConfig& config, std::ostream& out) -> AppExitCode;
+  // Points the converter at the current mapping snapshot and starts a
+  // validation pass against the same snapshot.
+  [[nodiscard]] auto BeginPass(const std::string& mapping_path)
+      -> std::optional<ValidationPass>;
+
   Converter converter_;
-  Validator validator_;
+  MappingCache mapping_cache_;
+  // Set while Handle() writes the JSON to stdout; meanwhile std::cout is
+  // redirected to stderr.
+  std::ostream* json_out_ = nullptr;
 };
 
 #endif // APPLICATION_FILE_PROCESSOR_HANDLER_HPP_
\ No newline at end of file
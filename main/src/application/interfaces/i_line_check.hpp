@@ -0,0 +1,30 @@
+// application/interfaces/i_line_check.hpp
+
+#ifndef APPLICATION_INTERFACES_I_LINE_CHECK_HPP_
+#define APPLICATION_INTERFACES_I_LINE_CHECK_HPP_
+
+#include <optional>
+#include <string_view>
+
+// Inspects the lines of a log as the parser reads them, so that a file can
+// be validated and parsed in the same pass.
+class ILineCheck {
+public:
+  virtual ~ILineCheck() = default;
+
+  // Called with every trimmed, non-blank line in file order; returns false
+  // once any error has been reported
+  virtual auto Check(std::string_view line) -> bool = 0;
+
+  // Called after the last line; returns true if the whole input passed
+  virtual auto Finish() -> bool = 0;
+
+  // Continues an input whose first `line_count` non-blank lines an earlier
+  // pass accepted; the next line must start a date block. `year` is the
+  // year those lines declared, against which later dates are checked.
+  virtual auto Resume(int line_count, std::optional<int> year) -> void = 0;
+
+  [[nodiscard]] virtual auto Passed() const -> bool = 0;
+};
+
+#endif // APPLICATION_INTERFACES_I_LINE_CHECK_HPP_
@@ -2,23 +2,66 @@
 #ifndef APPLICATION_INTERFACES_I_LOG_PARSER_HPP_
 #define APPLICATION_INTERFACES_I_LOG_PARSER_HPP_
 
+#include "application/interfaces/i_line_check.hpp"
+#include "domain/models/parse_checkpoint.hpp"
 #include "domain/models/workout_item.hpp"
+#include "domain/models/workout_log.hpp"
+#include <functional>
 #include <optional>
 #include <string>
-#include <vector>
 
+// Everything one parse produces. The parser itself keeps nothing.
+struct ParseResult {
+  bool success_ = false;
+  // The parsed days with the arena and symbols behind them; a streaming
+  // parse only fills the symbols
+  WorkoutLog log_;
+  std::optional<int> year_;
+  // Warnings and errors in file order, one per line
+  std::string diagnostics_;
+  // Streaming only: the last date line of a successful parse
+  std::optional<ParseCheckpoint> checkpoint_;
+  // A resumed parse whose checkpoint no longer matches the file; nothing
+  // was parsed
+  bool stale_checkpoint_ = false;
+};
+
+// Receives each completed day of a streaming parse together with the year
+// header seen so far. Returning false stops the parse.
+using ParsedDaySink = std::function<bool(
+    DailyData& day, SymbolTable& symbols, std::optional<int> year)>;
+
+// All members are const: a parser holds configuration only, so a single
+// instance can serve any number of threads at the same time.
 class ILogParser {
 public:
   virtual ~ILogParser() = default;
 
-  // Parse the source (e.g., file path) and return the parsed data if successful
-  virtual auto ParseFile(const std::string& source) -> bool = 0;
+  // Parse the source (e.g., file path) in one go
+  virtual auto ParseFile(const std::string& source) const -> ParseResult = 0;
+
+  // Parse the source incrementally, handing each day to `sink` as soon as its
+  // date block closes; memory stays bounded by the largest single day
+  virtual auto ParseFileStreaming(const std::string& source,
+                                  const ParsedDaySink& sink) const
+      -> ParseResult = 0;
 
-  // Get the parsed data
-  virtual auto GetParsedData() const -> const std::vector<DailyData>& = 0;
+  // Fused validate+parse: every non-blank line goes through `check` before
+  // the parser sees it. Days are only built while the check passes, and the
+  // result only succeeds if both the check and the parse do
+  virtual auto ParseFile(const std::string& source, ILineCheck& check) const
+      -> ParseResult = 0;
+  virtual auto ParseFileStreaming(const std::string& source,
+                                  const ParsedDaySink& sink,
+                                  ILineCheck& check) const -> ParseResult = 0;
 
-  // Get the parsed year if available
-  virtual auto GetParsedYear() const -> std::optional<int> = 0;
+  // Checked streaming parse of an append-only log that starts at `from`, the
+  // checkpoint of an earlier parse, once the file is confirmed to still
+  // begin with the same bytes
+  virtual auto ParseFileStreaming(const std::string& source,
+                                  const ParsedDaySink& sink, ILineCheck& check,
+                                  const ParseCheckpoint& from) const
+      -> ParseResult = 0;
 };
 
 #endif // APPLICATION_INTERFACES_I_LOG_PARSER_HPP_
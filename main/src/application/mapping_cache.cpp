@@ -0,0 +1,98 @@
+// application/mapping_cache.cpp
+
+#include "application/mapping_cache.hpp"
+
+#include <iostream>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "infrastructure/config/embedded_mapping.hpp"
+
+MappingCache::MappingCache(IMappingProvider& mapping_provider)
+    : mapping_provider_(mapping_provider) {}
+
+auto MappingCache::Get(const std::string& mapping_file_path)
+    -> std::shared_ptr<const MappingSnapshot> {
+  const std::lock_guard<std::mutex> kLock(mutex_);
+
+  FileStamp stamp;
+  const bool kStamped = Stamp(mapping_file_path, stamp);
+  if (snapshot_ != nullptr && kStamped && mapping_file_path == path_ &&
+      stamp == stamp_) {
+    return snapshot_;
+  }
+
+  snapshot_ = Load(mapping_file_path);
+  path_ = kStamped && snapshot_ != nullptr ? mapping_file_path : std::string();
+  stamp_ = stamp;
+  return snapshot_;
+}
+
+auto MappingCache::Stamp(const std::string& mapping_file_path,
+                         FileStamp& stamp) -> bool {
+  std::error_code error;
+  if (!std::filesystem::exists(mapping_file_path, error)) {
+    stamp = FileStamp{};
+    stamp.exists_ = false;
+    return !error;
+  }
+  stamp.modified_ = std::filesystem::last_write_time(mapping_file_path, error);
+  if (error) {
+    return false;
+  }
+  stamp.size_ = std::filesystem::file_size(mapping_file_path, error);
+  return !error;
+}
+
+auto MappingCache::Load(const std::string& mapping_file_path)
+    -> std::shared_ptr<const MappingSnapshot> {
+  switch (embedded_mapping::CheckFile(mapping_file_path)) {
+    case embedded_mapping::FileStatus::kMissing:
+      std::cout << "[MappingCache] " << mapping_file_path
+                << " not found; using the built-in mappings." << std::endl;
+      return LoadEmbedded();
+    case embedded_mapping::FileStatus::kUnchanged:
+      std::cout << "[MappingCache] Using the built-in mappings ("
+                << mapping_file_path << " is unchanged)." << std::endl;
+      return LoadEmbedded();
+    case embedded_mapping::FileStatus::kChanged:
+      break;
+  }
+
+  auto json_data_opt = mapping_provider_.GetMappingData(mapping_file_path);
+  if (!json_data_opt.has_value()) {
+    std::cerr << "Error: [MappingCache] Failed to read or parse mapping file: "
+              << mapping_file_path << std::endl;
+    return nullptr;
+  }
+  const cJSON* root = json_data_opt.value().get();
+
+  auto mapper = std::make_shared<ProjectNameMapper>();
+  if (!mapper->LoadMappings(root)) {
+    std::cerr << "Error: [MappingCache] Failed to load mappings from JSON data."
+              << std::endl;
+    return nullptr;
+  }
+  auto rules = Validator::LoadRules(root);
+  if (rules == nullptr) {
+    return nullptr;
+  }
+
+  std::cout << "[MappingCache] Mappings loaded from " << mapping_file_path
+            << std::endl;
+  return std::make_shared<const MappingSnapshot>(
+      MappingSnapshot{.mapper_ = std::move(mapper), .rules_ = std::move(rules)});
+}
+
+auto MappingCache::LoadEmbedded() -> std::shared_ptr<const MappingSnapshot> {
+  auto mapper = std::make_shared<ProjectNameMapper>();
+  mapper->UseEmbeddedMappings();
+  const std::span<const std::string_view> kTitles = embedded_mapping::Titles();
+  auto rules = Validator::BuildRules(
+      std::vector<std::string>(kTitles.begin(), kTitles.end()));
+  return std::make_shared<const MappingSnapshot>(
+      MappingSnapshot{.mapper_ = std::move(mapper), .rules_ = std::move(rules)});
+}
@@ -0,0 +1,69 @@
+// application/mapping_cache.hpp
+
+#ifndef APPLICATION_MAPPING_CACHE_HPP_
+#define APPLICATION_MAPPING_CACHE_HPP_
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "application/interfaces/i_mapping_provider.hpp"
+#include "infrastructure/converter/project_name_mapper.hpp"
+#include "infrastructure/validation/validator.hpp"
+
+// Everything built from one version of the mapping file: the name mapper
+// the converter applies and the rules the validator checks titles against.
+// Immutable, so the converter and any number of validation passes share it.
+struct MappingSnapshot {
+  std::shared_ptr<const ProjectNameMapper> mapper_;
+  std::shared_ptr<const ValidationRules> rules_;
+};
+
+/**
+ * @brief Reads and compiles the mapping file once per process.
+ *
+ * Processing a directory checks every file against the same mapping, so the
+ * snapshot is kept and handed out again for as long as the file's
+ * modification time and size stay the same. A file that is missing, or
+ * identical to the one the program was built with, is not parsed at all:
+ * the built-in mapping stands in for it. Get() may be called from several
+ * threads.
+ */
+class MappingCache {
+public:
+  explicit MappingCache(IMappingProvider& mapping_provider);
+
+  // nullptr if the mapping cannot be read or is not a JSON object; the
+  // error has been reported.
+  [[nodiscard]] auto Get(const std::string& mapping_file_path)
+      -> std::shared_ptr<const MappingSnapshot>;
+
+private:
+  struct FileStamp {
+    std::filesystem::file_time_type modified_;
+    std::uintmax_t size_ = 0;
+    bool exists_ = true;
+
+    auto operator==(const FileStamp&) const -> bool = default;
+  };
+
+  // False if the source is neither missing nor a file whose time and size
+  // can be read; it is then read again on every Get().
+  [[nodiscard]] static auto Stamp(const std::string& mapping_file_path,
+                                  FileStamp& stamp) -> bool;
+
+  [[nodiscard]] auto Load(const std::string& mapping_file_path)
+      -> std::shared_ptr<const MappingSnapshot>;
+  [[nodiscard]] static auto LoadEmbedded()
+      -> std::shared_ptr<const MappingSnapshot>;
+
+  IMappingProvider& mapping_provider_;
+  std::mutex mutex_;
+  std::string path_;
+  FileStamp stamp_;
+  std::shared_ptr<const MappingSnapshot> snapshot_;
+};
+
+#endif // APPLICATION_MAPPING_CACHE_HPP_
@@ -3,6 +3,7 @@
 #define CLI_COMMANDS_CONVERT_COMMAND_HPP_
 
 #include "cli/framework/command.hpp"
+#include "common/input_file.hpp"
 #include <iostream>
 
 namespace cli {
@@ -15,7 +16,8 @@ public:
   auto GetCategory() const -> std::string override { return "Project Tools"; }
 
   auto GetDescription() const -> std::string override {
-    return "Convert the log file to JSON format.";
+    return "Convert the log file to JSON format ('-' or --stdin reads stdin, "
+           "--stdout writes the JSON to stdout).";
   }
 
   auto Parse(const std::vector<std::string>& args, AppConfig& config) -> bool override {
@@ -25,7 +27,17 @@ public:
       return false;
     }
     config.action_ = ActionType::Convert;
-    config.log_filepath_ = args[1];
+    config.log_filepath_ =
+        args[1] == "--stdin" ? std::string(InputFile::kStdinPath) : args[1];
+    for (size_t i = 2; i < args.size(); ++i) {
+      if (args[i] == "--stdout") {
+        config.json_to_stdout_ = true;
+      }
+    }
+    // A log from stdin has no name to derive an output file from.
+    if (InputFile::IsStdin(config.log_filepath_)) {
+      config.json_to_stdout_ = true;
+    }
     return true;
   }
 };
@@ -3,6 +3,7 @@
 #define CLI_COMMANDS_INGEST_COMMAND_HPP_
 
 #include "cli/framework/command.hpp"
+#include "common/input_file.hpp"
 #include <iostream>
 
 namespace cli {
@@ -15,7 +16,7 @@ public:
   auto GetCategory() const -> std::string override { return "Storage & Output"; }
 
   auto GetDescription() const -> std::string override {
-    return "Read a log file, validate/convert it, and insert directly to DB (skips JSON).";
+    return "Read a log file, validate/convert it, and insert directly to DB (skips JSON; '-' or --stdin reads stdin).";
   }
 
   auto Parse(const std::vector<std::string>& args, AppConfig& config) -> bool override {
@@ -25,7 +26,8 @@ public:
       return false;
     }
     config.action_ = ActionType::Ingest;
-    config.log_filepath_ = args[1];
+    config.log_filepath_ =
+        args[1] == "--stdin" ? std::string(InputFile::kStdinPath) : args[1];
     return true;
   }
 };
@@ -0,0 +1,36 @@
+// cli/commands/remap_command.hpp
+#ifndef CLI_COMMANDS_REMAP_COMMAND_HPP_
+#define CLI_COMMANDS_REMAP_COMMAND_HPP_
+
+#include "cli/framework/command.hpp"
+#include <iostream>
+
+namespace cli {
+namespace commands {
+
+class RemapCommand : public framework::Command {
+public:
+  auto GetName() const -> std::string override { return "remap"; }
+
+  auto GetCategory() const -> std::string override { return "Storage & Output"; }
+
+  auto GetDescription() const -> std::string override {
+    return "Re-apply mapping.json to the exercise names and types already in the database.";
+  }
+
+  auto Parse(const std::vector<std::string>& args, AppConfig& config) -> bool override {
+    if (args.size() > 1) {
+      std::cerr
+          << "Error: 'remap' command does not take any additional arguments."
+          << std::endl;
+      return false;
+    }
+    config.action_ = ActionType::Remap;
+    return true;
+  }
+};
+
+} // namespace commands
+} // namespace cli
+
+#endif // CLI_COMMANDS_REMAP_COMMAND_HPP_
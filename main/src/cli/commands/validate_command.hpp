@@ -3,6 +3,7 @@
 #define CLI_COMMANDS_VALIDATE_COMMAND_HPP_
 
 #include "cli/framework/command.hpp"
+#include <charconv>
 #include <iostream>
 
 namespace cli {
@@ -15,7 +16,9 @@ public:
   auto GetCategory() const -> std::string override { return "Project Tools"; }
 
   auto GetDescription() const -> std::string override {
-    return "Only validate the log file format.";
+    return "Only validate the log file format (--jobs N checks N files at a "
+           "time, --max-errors N and --fail-fast stop early, --json prints a "
+           "report on stdout).";
   }
 
   auto Parse(const std::vector<std::string>& args, AppConfig& config) -> bool override {
@@ -26,6 +29,51 @@ public:
     }
     config.action_ = ActionType::Validate;
     config.log_filepath_ = args[1];
+    for (size_t i = 2; i < args.size(); ++i) {
+      if (args[i] == "--jobs" || args[i] == "-j") {
+        if (!ParseCount("--jobs", args, ++i, config.jobs_)) {
+          return false;
+        }
+      } else if (args[i] == "--max-errors") {
+        if (!ParseCount("--max-errors", args, ++i, config.max_errors_)) {
+          return false;
+        }
+      } else if (args[i] == "--fail-fast") {
+        config.fail_fast_ = true;
+      } else if (args[i] == "--json") {
+        config.json_to_stdout_ = true;
+      } else {
+        std::cerr << "Error: 'validate' command does not recognize the "
+                  << "argument '" << args[i] << "'." << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  // Parses args[index], the value of `option`; a missing value is an error
+  // too, rather than a silent fall back to the default.
+  static auto ParseCount(const std::string& option,
+                         const std::vector<std::string>& args, size_t index,
+                         unsigned& count) -> bool {
+    if (index >= args.size()) {
+      std::cerr << "Error: " << option << " expects a number, got nothing."
+                << std::endl;
+      return false;
+    }
+    return ParseCount(option, args[index], count);
+  }
+
+  static auto ParseCount(const std::string& option, const std::string& value,
+                         unsigned& count) -> bool {
+    const char* const kEnd = value.data() + value.size();
+    auto [end, ec] = std::from_chars(value.data(), kEnd, count);
+    if (ec != std::errc() || end != kEnd) {
+      std::cerr << "Error: " << option << " expects a number, got '" << value
+                << "'." << std::endl;
+      return false;
+    }
     return true;
   }
 };
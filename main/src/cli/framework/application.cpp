@@ -98,12 +98,8 @@ auto Application::ResolveConfigPaths(AppConfig& config,
     fs::path mapping_file = config_dir / "mapping.json";
 
     config.base_path_ = exe_dir.string();
+    // Without the file the built-in mapping is used (see MappingCache).
     config.mapping_path_ = mapping_file.string();
-
-    if (!fs::exists(config.mapping_path_)) {
-      std::cerr << "Warning: Configuration file not found at: "
-                << config.mapping_path_ << std::endl;
-    }
   } catch (const fs::filesystem_error& e) {
     std::cerr << "Error resolving paths: " << e.what() << std::endl;
   }
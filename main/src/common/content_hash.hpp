@@ -0,0 +1,34 @@
+// common/content_hash.hpp
+
+#ifndef COMMON_CONTENT_HASH_HPP_
+#define COMMON_CONTENT_HASH_HPP_
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief 64-bit FNV-1a over raw bytes.
+ *
+ * The value only depends on the bytes, never on the platform or the build,
+ * so it can be stored and compared by a later run. Hashing is incremental:
+ * Update(Update(kInitial, a), b) == Update(kInitial, a + b), so a stream can
+ * be hashed block by block and split at any byte.
+ */
+struct ContentHash {
+  using Value = std::uint64_t;
+
+  static constexpr Value kInitial = 14695981039346656037ULL;
+  static constexpr Value kPrime = 1099511628211ULL;
+
+  [[nodiscard]] static constexpr auto Update(Value hash,
+                                             std::string_view bytes)
+      -> Value {
+    for (const char kByte : bytes) {
+      hash ^= static_cast<unsigned char>(kByte);
+      hash *= kPrime;
+    }
+    return hash;
+  }
+};
+
+#endif // COMMON_CONTENT_HASH_HPP_
@@ -5,8 +5,20 @@
 #include <filesystem>
 #include <iostream>
 
+#include "common/input_file.hpp"
+
 namespace fs = std::filesystem;
 
+namespace {
+
+// "log.txt" and "log.txt.gz" both have the extension ".txt".
+auto HasExtension(const fs::path& file_path, const std::string& extension)
+    -> bool {
+  return InputFile::WithoutCompression(file_path).extension() == extension;
+}
+
+}  // namespace
+
 auto FileReader::FindFilesByExtension(const std::string& path,
                                       const std::string& extension)
     -> std::vector<std::string> {
@@ -22,12 +34,12 @@ auto FileReader::FindFilesByExtension(const std::string& path,
     std::cout << "[FileReader] Path is a directory. Recursively searching for '"
               << extension << "' files..." << std::endl;
     for (const auto& entry : fs::recursive_directory_iterator(path)) {
-      if (entry.is_regular_file() && entry.path().extension() == extension) {
+      if (entry.is_regular_file() && HasExtension(entry.path(), extension)) {
         file_paths.push_back(entry.path().string());
       }
     }
   } else if (fs::is_regular_file(path)) {
-    if (fs::path(path).extension() == extension) {
+    if (HasExtension(path, extension)) {
       file_paths.push_back(path);
     } else {
       std::cerr << "Warning: [FileReader] Specified file does not have the '"
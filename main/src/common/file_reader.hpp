@@ -10,6 +10,8 @@ class FileReader {
 public:
   /**
    * @brief Recursively finds all files with a specific extension from a given path.
+   *
+   * Gzip-compressed files count as well: "log.txt.gz" matches ".txt".
    * @param path The directory or file path to search.
    * @param extension The file extension to search for (e.g., ".txt", ".json").
    * @return A vector of strings containing full paths to matching files.
@@ -0,0 +1,170 @@
+// common/input_file.cpp
+
+#include "common/input_file.hpp"
+
+#include <iostream>
+#include <streambuf>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef WORKOUT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+constexpr std::string_view kGzipExtension = ".gz";
+
+}  // namespace
+
+#ifdef WORKOUT_HAVE_ZLIB
+
+// Inflates gzip data read from `source`. Only one input and one output
+// buffer exist; each underflow() refills the output buffer.
+class InputFile::GzipBuffer : public std::streambuf {
+public:
+  GzipBuffer(std::streambuf& source, std::string file_path,
+             std::ostream& errors)
+      : source_(source),
+        errors_(errors),
+        file_path_(std::move(file_path)),
+        input_(kBufferBytes),
+        output_(kBufferBytes) {
+    // 16 + MAX_WBITS: expect a gzip header and trailer, not a raw zlib one.
+    if (inflateInit2(&stream_, 16 + MAX_WBITS) != Z_OK) {
+      Fail("could not initialize zlib");
+      return;
+    }
+    initialized_ = true;
+  }
+
+  ~GzipBuffer() override {
+    if (initialized_) {
+      inflateEnd(&stream_);
+    }
+  }
+
+  GzipBuffer(const GzipBuffer&) = delete;
+  auto operator=(const GzipBuffer&) -> GzipBuffer& = delete;
+  GzipBuffer(GzipBuffer&&) = delete;
+  auto operator=(GzipBuffer&&) -> GzipBuffer& = delete;
+
+  [[nodiscard]] auto Failed() const -> bool { return failed_; }
+
+protected:
+  auto underflow() -> int_type override {
+    if (gptr() < egptr()) {
+      return traits_type::to_int_type(*gptr());
+    }
+    while (initialized_ && !failed_) {
+      if (stream_.avail_in == 0) {
+        const std::streamsize kRead = source_.sgetn(
+            input_.data(), static_cast<std::streamsize>(input_.size()));
+        if (kRead <= 0) {
+          if (in_member_) {
+            Fail("unexpected end of compressed data");
+          }
+          break;
+        }
+        stream_.next_in = reinterpret_cast<Bytef*>(input_.data());
+        stream_.avail_in = static_cast<uInt>(kRead);
+      }
+      if (!in_member_) {
+        // The next member of a concatenated file continues the same text.
+        inflateReset(&stream_);
+        in_member_ = true;
+      }
+
+      stream_.next_out = reinterpret_cast<Bytef*>(output_.data());
+      stream_.avail_out = static_cast<uInt>(output_.size());
+      const int kResult = inflate(&stream_, Z_NO_FLUSH);
+      if (kResult == Z_STREAM_END) {
+        in_member_ = false;
+      } else if (kResult != Z_OK && kResult != Z_BUF_ERROR) {
+        Fail(stream_.msg != nullptr ? stream_.msg : "invalid compressed data");
+        break;
+      }
+
+      const size_t kProduced = output_.size() - stream_.avail_out;
+      if (kProduced > 0) {
+        setg(output_.data(), output_.data(), output_.data() + kProduced);
+        return traits_type::to_int_type(*gptr());
+      }
+    }
+    return traits_type::eof();
+  }
+
+private:
+  static constexpr size_t kBufferBytes = 256 * 1024;
+
+  auto Fail(const char* reason) -> void {
+    errors_ << "Error: [InputFile] Failed to decompress " << file_path_
+              << ": " << reason << std::endl;
+    failed_ = true;
+  }
+
+  std::streambuf& source_;
+  std::ostream& errors_;
+  std::string file_path_;
+  std::vector<char> input_;
+  std::vector<char> output_;
+  z_stream stream_{};
+  bool initialized_ = false;
+  bool in_member_ = false;
+  bool failed_ = false;
+};
+
+#else
+
+class InputFile::GzipBuffer : public std::streambuf {
+public:
+  [[nodiscard]] static auto Failed() -> bool { return true; }
+};
+
+#endif
+
+InputFile::InputFile() : InputFile(std::cerr) {}
+
+InputFile::InputFile(std::ostream& errors) : errors_(&errors) {}
+
+InputFile::~InputFile() = default;
+
+auto InputFile::Open(const std::string& file_path) -> bool {
+  if (IsStdin(file_path)) {
+    stream_.rdbuf(std::cin.rdbuf());
+    return true;
+  }
+  if (file_.open(file_path, std::ios::in | std::ios::binary) == nullptr) {
+    return false;
+  }
+  if (!IsCompressed(file_path)) {
+    stream_.rdbuf(&file_);
+    return true;
+  }
+#ifdef WORKOUT_HAVE_ZLIB
+  gzip_ = std::make_unique<GzipBuffer>(file_, file_path, *errors_);
+  stream_.rdbuf(gzip_.get());
+  return !gzip_->Failed();
+#else
+  *errors_ << "Error: [InputFile] Cannot read " << file_path
+            << ": this build has no zlib support for .gz files." << std::endl;
+  return false;
+#endif
+}
+
+auto InputFile::Failed() const -> bool {
+  return gzip_ != nullptr && gzip_->Failed();
+}
+
+auto InputFile::IsCompressed(const std::filesystem::path& file_path) -> bool {
+  return file_path.extension() == kGzipExtension;
+}
+
+auto InputFile::WithoutCompression(const std::filesystem::path& file_path)
+    -> std::filesystem::path {
+  if (!IsCompressed(file_path)) {
+    return file_path;
+  }
+  return std::filesystem::path(file_path).replace_extension();
+}
@@ -0,0 +1,74 @@
+// common/input_file.hpp
+
+#ifndef COMMON_INPUT_FILE_HPP_
+#define COMMON_INPUT_FILE_HPP_
+
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Sequential read access to a log or JSON file, compressed or not.
+ *
+ * Paths ending in ".gz" are inflated on the fly through fixed-size buffers,
+ * so an archived file is neither unpacked to disk nor held in memory as a
+ * whole. Concatenated gzip members (e.g. from `gzip -c >> log.txt.gz`) read
+ * as one stream. The path "-" stands for standard input. Any other file is
+ * read as it is.
+ */
+class InputFile {
+public:
+  static constexpr std::string_view kStdinPath = "-";
+
+  InputFile();
+  // Read errors are reported to `errors` instead of std::cerr.
+  explicit InputFile(std::ostream& errors);
+  ~InputFile();
+
+  InputFile(const InputFile&) = delete;
+  auto operator=(const InputFile&) -> InputFile& = delete;
+  InputFile(InputFile&&) = delete;
+  auto operator=(InputFile&&) -> InputFile& = delete;
+
+  /**
+   * @brief Opens the file for reading.
+   * @return false if it cannot be opened, or is compressed and this build
+   *         has no zlib.
+   */
+  [[nodiscard]] auto Open(const std::string& file_path) -> bool;
+
+  [[nodiscard]] auto Stream() -> std::istream& { return stream_; }
+
+  /**
+   * @brief True once compressed input turned out to be corrupt or cut off.
+   *
+   * The stream then simply ends early, so a reader has to check this after
+   * reaching the end. The error itself has already been reported.
+   */
+  [[nodiscard]] auto Failed() const -> bool;
+
+  [[nodiscard]] static auto IsStdin(std::string_view file_path) -> bool {
+    return file_path == kStdinPath;
+  }
+
+  [[nodiscard]] static auto IsCompressed(const std::filesystem::path& file_path)
+      -> bool;
+
+  // "log.txt.gz" -> "log.txt"; any other path is returned unchanged.
+  [[nodiscard]] static auto WithoutCompression(
+      const std::filesystem::path& file_path) -> std::filesystem::path;
+
+private:
+  class GzipBuffer;
+
+  std::ostream* errors_;
+  std::filebuf file_;
+  std::unique_ptr<GzipBuffer> gzip_;
+  std::istream stream_{nullptr};
+};
+
+#endif // COMMON_INPUT_FILE_HPP_
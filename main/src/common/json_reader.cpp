@@ -2,21 +2,27 @@
 
 #include "common/json_reader.hpp"
 
-#include <fstream>
 #include <iostream>
 #include <sstream>
 
+#include "common/input_file.hpp"
+
 auto JsonReader::ReadFile(const std::string& file_path)
     -> std::optional<CJsonPtr> {
-  std::ifstream json_file(file_path);
-  if (!json_file.is_open()) {
+  InputFile json_file;
+  if (!json_file.Open(file_path)) {
     std::cerr << "Error: [JsonReader] Could not open file " << file_path
               << std::endl;
     return std::nullopt;
   }
 
+  // cJSON only parses complete documents, so compressed input is inflated
+  // into the same single buffer a plain file is read into.
   std::stringstream buffer;
-  buffer << json_file.rdbuf();
+  buffer << json_file.Stream().rdbuf();
+  if (json_file.Failed()) {
+    return std::nullopt;
+  }
   std::string content = buffer.str();
 
   cJSON* raw_json = cJSON_Parse(content.c_str());
@@ -0,0 +1,146 @@
+// common/mapped_file.cpp
+
+#include "common/mapped_file.hpp"
+
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+  Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0))
+#ifdef _WIN32
+      ,
+      file_handle_(std::exchange(other.file_handle_, nullptr)),
+      mapping_handle_(std::exchange(other.mapping_handle_, nullptr))
+#endif
+{
+}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+  if (this != &other) {
+    Close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+    file_handle_ = std::exchange(other.file_handle_, nullptr);
+    mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+#endif
+  }
+  return *this;
+}
+
+#ifdef _WIN32
+
+auto MappedFile::Open(const std::string& file_path) -> bool {
+  Close();
+
+  HANDLE file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  LARGE_INTEGER file_size;
+  if (GetFileSizeEx(file, &file_size) == 0) {
+    CloseHandle(file);
+    return false;
+  }
+  if (file_size.QuadPart == 0) {
+    CloseHandle(file);
+    return true;
+  }
+
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    CloseHandle(file);
+    return false;
+  }
+
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view == nullptr) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  file_handle_ = file;
+  mapping_handle_ = mapping;
+  data_ = static_cast<const char*>(view);
+  size_ = static_cast<std::size_t>(file_size.QuadPart);
+  return true;
+}
+
+auto MappedFile::Close() -> void {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_handle_ != nullptr) {
+    CloseHandle(mapping_handle_);
+  }
+  if (file_handle_ != nullptr) {
+    CloseHandle(file_handle_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  mapping_handle_ = nullptr;
+  file_handle_ = nullptr;
+}
+
+#else
+
+auto MappedFile::Open(const std::string& file_path) -> bool {
+  Close();
+
+  const int kFd = ::open(file_path.c_str(), O_RDONLY);
+  if (kFd < 0) {
+    return false;
+  }
+
+  struct stat file_stat {};
+  if (::fstat(kFd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+    ::close(kFd);
+    return false;
+  }
+  if (file_stat.st_size == 0) {
+    ::close(kFd);
+    return true;
+  }
+
+  const auto kSize = static_cast<std::size_t>(file_stat.st_size);
+  void* view = ::mmap(nullptr, kSize, PROT_READ, MAP_PRIVATE, kFd, 0);
+  // The mapping keeps its own reference to the file.
+  ::close(kFd);
+  if (view == MAP_FAILED) {
+    return false;
+  }
+  ::madvise(view, kSize, MADV_SEQUENTIAL);
+
+  data_ = static_cast<const char*>(view);
+  size_ = kSize;
+  return true;
+}
+
+auto MappedFile::Close() -> void {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+}
+
+#endif
@@ -0,0 +1,49 @@
+// common/mapped_file.hpp
+
+#ifndef COMMON_MAPPED_FILE_HPP_
+#define COMMON_MAPPED_FILE_HPP_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The mapped bytes are exposed as a std::string_view so that callers can walk
+ * the content without copying it into std::string buffers. The view stays
+ * valid until Close() is called or the object is destroyed.
+ */
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  auto operator=(const MappedFile&) -> MappedFile& = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+  /**
+   * @brief Maps the given file into memory.
+   * @param file_path Path of the file to map.
+   * @return true on success. An empty file is a valid (empty) mapping.
+   */
+  [[nodiscard]] auto Open(const std::string& file_path) -> bool;
+
+  auto Close() -> void;
+
+  [[nodiscard]] auto View() const -> std::string_view {
+    return {data_, size_};
+  }
+
+private:
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+#ifdef _WIN32
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#endif
+};
+
+#endif // COMMON_MAPPED_FILE_HPP_
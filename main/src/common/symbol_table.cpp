@@ -0,0 +1,18 @@
+// common/symbol_table.cpp
+
+#include "common/symbol_table.hpp"
+
+SymbolTable::SymbolTable() {
+  strings_.emplace_back();
+  index_.emplace(strings_.back(), kEmpty);
+}
+
+auto SymbolTable::Intern(std::string_view text) -> SymbolId {
+  if (auto found = index_.find(text); found != index_.end()) {
+    return found->second;
+  }
+  const auto kId = static_cast<SymbolId>(strings_.size());
+  const std::string& stored = strings_.emplace_back(text);
+  index_.emplace(stored, kId);
+  return kId;
+}
@@ -0,0 +1,53 @@
+// common/symbol_table.hpp
+
+#ifndef COMMON_SYMBOL_TABLE_HPP_
+#define COMMON_SYMBOL_TABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using SymbolId = std::uint32_t;
+
+/**
+ * @brief Interning table that maps each distinct string to a small id.
+ *
+ * Exercise names and types repeat on almost every line of a log, so the
+ * models carry SymbolIds and compare/group by integer; the text is resolved
+ * only where it leaves the process (JSON, SQLite, reports). Id 0 is always
+ * the empty string, so a value-initialized id is a valid "no symbol".
+ */
+class SymbolTable {
+public:
+  static constexpr SymbolId kEmpty = 0;
+
+  SymbolTable();
+
+  SymbolTable(const SymbolTable&) = delete;
+  auto operator=(const SymbolTable&) -> SymbolTable& = delete;
+  SymbolTable(SymbolTable&&) noexcept = default;
+  auto operator=(SymbolTable&&) noexcept -> SymbolTable& = default;
+  ~SymbolTable() = default;
+
+  // Returns the id of `text`, adding it on first sight.
+  [[nodiscard]] auto Intern(std::string_view text) -> SymbolId;
+
+  // The view stays valid for the lifetime of the table (moves included) and
+  // is NUL-terminated, so it can be handed to C APIs through data().
+  [[nodiscard]] auto Resolve(SymbolId symbol_id) const -> std::string_view {
+    return strings_[symbol_id];
+  }
+
+  [[nodiscard]] auto Size() const -> std::size_t { return strings_.size(); }
+
+private:
+  // A deque never relocates its elements, so the keys of index_ can view
+  // into the stored strings directly.
+  std::deque<std::string> strings_;
+  std::unordered_map<std::string_view, SymbolId> index_;
+};
+
+#endif // COMMON_SYMBOL_TABLE_HPP_
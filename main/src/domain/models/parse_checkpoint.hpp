@@ -0,0 +1,33 @@
+// domain/models/parse_checkpoint.hpp
+#ifndef DOMAIN_MODELS_PARSE_CHECKPOINT_HPP_
+#define DOMAIN_MODELS_PARSE_CHECKPOINT_HPP_
+
+#include <cstdint>
+#include <optional>
+
+// Where a later run over an append-only log can pick up: the last date line
+// of the file. Every day before it is complete. The last day may still grow,
+// so a resumed parse starts by reading it again.
+struct ParseCheckpoint {
+  std::uint64_t offset_ = 0;        // first byte of the last date line
+  std::uint64_t hashed_bytes_ = 0;  // prefix covered by prefix_hash_; it
+                                    // ends after that date line's text
+  std::uint64_t prefix_hash_ = 0;   // ContentHash of the prefix
+  int year_ = 0;
+  int line_count_ = 0;          // physical lines before offset_
+  int checked_line_count_ = 0;  // non-blank lines before offset_
+  int sealed_days_ = 0;         // complete days before offset_
+};
+
+// In/out state of a streaming conversion that may continue an earlier one.
+struct StreamResume {
+  // In: where to start. If the file no longer begins with the bytes the
+  // checkpoint was taken over, nothing is parsed and `stale_` is set; the
+  // caller then has to start over from the top.
+  std::optional<ParseCheckpoint> from_;
+  // Out: where the next run may start, once the whole file has been read.
+  std::optional<ParseCheckpoint> next_;
+  bool stale_ = false;
+};
+
+#endif // DOMAIN_MODELS_PARSE_CHECKPOINT_HPP_
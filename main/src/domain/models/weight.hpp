@@ -0,0 +1,53 @@
+// domain/models/weight.hpp
+#ifndef DOMAIN_MODELS_WEIGHT_HPP_
+#define DOMAIN_MODELS_WEIGHT_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+// 重量的定点表示。
+// 所有重量在解析时一次性换算为整数克; 容量 (重量 x 次数) 以 "克·次"
+// 的 int64 累加, 多年的总量也是精确的。只有在输出 (JSON / 报告 / 统计)
+// 时才换回 kg 或 lbs。
+struct Weight {
+  using Grams = std::int32_t;     // 约 ±2147 kg
+  using GramReps = std::int64_t;  // 容量
+
+  static constexpr double kGramsPerKg = 1000.0;
+  static constexpr double kGramsPerLb = 453.59237;
+  // 换回 lbs 时保留两位小数: 1 克远小于 0.01 lbs,
+  // 因此两位小数以内的 lbs 输入都能原样还原
+  static constexpr double kLbsScale = 100.0;
+
+  // 超出 Grams 范围 (或不是有限数) 时返回 nullopt
+  [[nodiscard]] static auto FromKg(double kg) -> std::optional<Grams> {
+    return Round(kg * kGramsPerKg);
+  }
+
+  [[nodiscard]] static auto FromLbs(double lbs) -> std::optional<Grams> {
+    return Round(lbs * kGramsPerLb);
+  }
+
+  [[nodiscard]] static auto ToKg(GramReps grams) -> double {
+    return static_cast<double>(grams) / kGramsPerKg;
+  }
+
+  [[nodiscard]] static auto ToLbs(GramReps grams) -> double {
+    return std::round(static_cast<double>(grams) / kGramsPerLb * kLbsScale) /
+           kLbsScale;
+  }
+
+private:
+  [[nodiscard]] static auto Round(double grams) -> std::optional<Grams> {
+    constexpr auto kLimit =
+        static_cast<double>(std::numeric_limits<Grams>::max());
+    if (!(std::abs(grams) <= kLimit)) {
+      return std::nullopt;
+    }
+    return static_cast<Grams>(std::llround(grams));
+  }
+};
+
+#endif // DOMAIN_MODELS_WEIGHT_HPP_
@@ -2,37 +2,127 @@
 #ifndef DOMAIN_MODELS_WORKOUT_ITEM_HPP_
 #define DOMAIN_MODELS_WORKOUT_ITEM_HPP_
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <numeric>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-// 定义每一组的具体数据
+#include "common/symbol_table.hpp"
+#include "domain/models/weight.hpp"
+
+// 模型中的字符串与向量都使用 polymorphic_allocator,
+// 以便整棵树可以由同一个 arena (见 workout_log.hpp) 提供内存。
+// ProjectData / DailyData 因此是 allocator-aware 的: 容器通过
+// uses-allocator 构造把 arena 一层层传递下去, 且两者都是 move-only。
+// 带 allocator 的移动构造在两边 arena 不同时仍会逐元素复制,
+// 编译期无法禁止; tests/zero_copy_test.cpp 检查转换与插入路径没有这种复制。
+// SetData 只有 16 字节, 不持有任何内存, 可以随意复制。
+
+// 一个 run: 同一 project 中连续的、重量/次数/备注都相同的若干组。
+// "+60 5+5+5 // note" 只存一条 {60, 5, count 3};
+// 备注文本存放在所属 DailyData::set_notes_ 中, 这里只保存下标。
+// 组号不再存储, 由 run 在 project 中的位置推算 (见 ProjectData::ForEachSet)。
 struct SetData {
-  int set_number_;          // 组号 (e.g., 1, 2, 3...)
-  double weight_;           // 这组的重量
-  int reps_;                // 这组的次数
-  double volume_{0.0};      // volume = weight * reps
-  std::string note_;        // set note
+  static constexpr std::uint16_t kNoNote = 0xFFFF;
+  static constexpr std::uint16_t kMaxCount = 0xFFFF;
+
+  Weight::Grams weight_g_{0};           // 重量 (克), 负数表示弹力带助力
+  std::int32_t reps_{0};                // 这组的次数
+  std::uint16_t count_{1};              // 该 run 包含的组数
+  std::uint16_t note_index_{kNoNote};   // DailyData::set_notes_ 的下标
+
+  // volume = weight * reps (克·次); 弹力带助力 (负重量) 不计容量
+  [[nodiscard]] auto Volume() const -> Weight::GramReps {
+    if (weight_g_ <= 0 || reps_ <= 0) return 0;
+    return static_cast<Weight::GramReps>(weight_g_) * reps_;
+  }
 
+  // 1RM 估算, 单位 kg
   [[nodiscard]] auto CalculateEpley() const -> double {
-    if (reps_ <= 1) return weight_;
-    return weight_ * (1.0 + static_cast<double>(reps_) / 30.0);
+    const double kWeight = Weight::ToKg(weight_g_);
+    if (reps_ <= 1) return kWeight;
+    return kWeight * (1.0 + static_cast<double>(reps_) / 30.0);
   }
 
   [[nodiscard]] auto CalculateBrzycki() const -> double {
-    if (reps_ <= 1) return weight_;
-    if (reps_ >= 37) return weight_ * 36.0; // Avoid division by zero/negative
-    return weight_ * (36.0 / (37.0 - static_cast<double>(reps_)));
+    const double kWeight = Weight::ToKg(weight_g_);
+    if (reps_ <= 1) return kWeight;
+    if (reps_ >= 37) return kWeight * 36.0; // Avoid division by zero/negative
+    return kWeight * (36.0 / (37.0 - static_cast<double>(reps_)));
   }
 };
 
 struct ProjectData {
-  std::string project_name_;   // 运动的名称
-  std::string note_;           // project note
-  std::string type_;           // 运动的类型,例如卧推是push
-  std::vector<SetData> sets_;  // 包含所有组的向量
-  double total_volume_{0.0};   // 这个项目的总容量
-  int line_number_;            // 该项目在文件中的起始行号
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  ProjectData() = default;
+  explicit ProjectData(const allocator_type& alloc)
+      : note_(alloc), sets_(alloc) {}
+  ProjectData(ProjectData&& other, const allocator_type& alloc)
+      : project_name_id_(other.project_name_id_),
+        short_name_id_(other.short_name_id_),
+        note_(std::move(other.note_), alloc),
+        type_id_(other.type_id_),
+        sets_(std::move(other.sets_), alloc),
+        total_volume_g_(other.total_volume_g_),
+        line_number_(other.line_number_) {}
+  ProjectData(const ProjectData&) = delete;
+  ProjectData(ProjectData&&) noexcept = default;
+  auto operator=(const ProjectData&) -> ProjectData& = delete;
+  auto operator=(ProjectData&&) noexcept -> ProjectData& = default;
+  ~ProjectData() = default;
+
+  // 名称与类型以 SymbolId 存储, 文本见 WorkoutLog::Symbols()
+  SymbolId project_name_id_{SymbolTable::kEmpty};  // 运动的名称
+  // 日志中写的简称 (映射的键); 映射只改写 project_name_id_
+  SymbolId short_name_id_{SymbolTable::kEmpty};
+  std::pmr::string note_;                          // project note
+  SymbolId type_id_{SymbolTable::kEmpty};          // 运动的类型,例如卧推是push
+  std::pmr::vector<SetData> sets_;   // 按组号顺序排列的 run
+  Weight::GramReps total_volume_g_{0};  // 这个项目的总容量 (克·次)
+  int line_number_{0};               // 该项目在文件中的起始行号
+
+  // 追加一组; 与最后一个 run 完全相同时只增加其计数
+  auto AddSet(Weight::Grams weight_g, std::int32_t reps,
+              std::uint16_t note_index) -> void {
+    if (!sets_.empty()) {
+      SetData& last = sets_.back();
+      if (last.weight_g_ == weight_g && last.reps_ == reps &&
+          last.note_index_ == note_index && last.count_ < SetData::kMaxCount) {
+        ++last.count_;
+        return;
+      }
+    }
+    sets_.push_back(SetData{.weight_g_ = weight_g,
+                            .reps_ = reps,
+                            .count_ = 1,
+                            .note_index_ = note_index});
+  }
+
+  [[nodiscard]] auto SetCount() const -> std::size_t {
+    return std::accumulate(
+        sets_.begin(), sets_.end(), std::size_t{0},
+        [](std::size_t total, const SetData& run) -> std::size_t {
+          return total + run.count_;
+        });
+  }
+
+  // 按组号顺序展开所有 run, 对每一组调用 fn(set_number, run)
+  template <typename Fn>
+  auto ForEachSet(Fn&& fn) const -> void {
+    int set_number = 0;
+    for (const SetData& run : sets_) {
+      for (std::uint16_t i = 0; i < run.count_; ++i) {
+        fn(++set_number, run);
+      }
+    }
+  }
 };
 
 /**
@@ -42,9 +132,65 @@ struct ProjectData {
  * type safety throughout the application layers.
  */
 struct DailyData {
-  std::string date_;
-  std::string note_;
-  std::vector<ProjectData> projects_;
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  DailyData() = default;
+  explicit DailyData(const allocator_type& alloc)
+      : note_(alloc), projects_(alloc), set_notes_(alloc) {}
+  DailyData(DailyData&& other, const allocator_type& alloc)
+      : month_day_(other.month_day_),
+        date_(other.date_),
+        note_(std::move(other.note_), alloc),
+        projects_(std::move(other.projects_), alloc),
+        set_notes_(std::move(other.set_notes_), alloc) {}
+  DailyData(const DailyData&) = delete;
+  DailyData(DailyData&&) noexcept = default;
+  auto operator=(const DailyData&) -> DailyData& = delete;
+  auto operator=(DailyData&&) noexcept -> DailyData& = default;
+  ~DailyData() = default;
+
+  // 日志中的 MMDD; 年份由 DateService 补全到 date_
+  std::chrono::month_day month_day_{};
+  // 完整日期, 以 1970-01-01 起的天数存储; 只在输出时格式化为 YYYY-MM-DD
+  std::chrono::sys_days date_{};
+  std::pmr::string note_;
+  std::pmr::vector<ProjectData> projects_;
+  // 当天所有组备注的文本, 由 SetData::note_index_ 引用
+  std::pmr::vector<std::pmr::string> set_notes_;
+
+  // 登记一条组备注并返回其下标; 与上一条相同的备注只存一次。
+  // 空备注或表已满时返回 SetData::kNoNote
+  auto AddSetNote(std::string_view note) -> std::uint16_t {
+    if (note.empty()) {
+      return SetData::kNoNote;
+    }
+    if (!set_notes_.empty() && set_notes_.back() == note) {
+      return static_cast<std::uint16_t>(set_notes_.size() - 1);
+    }
+    if (set_notes_.size() >= SetData::kNoNote) {
+      return SetData::kNoNote;
+    }
+    set_notes_.emplace_back(note);
+    return static_cast<std::uint16_t>(set_notes_.size() - 1);
+  }
+
+  [[nodiscard]] auto SetNote(std::uint16_t note_index) const
+      -> std::string_view {
+    if (note_index >= set_notes_.size()) {
+      return "";
+    }
+    return set_notes_[note_index];
+  }
 };
 
+static_assert(sizeof(SetData) <= 16 &&
+                  std::is_trivially_copyable_v<SetData>,
+              "sets are packed runs; keep them within 16 bytes");
+static_assert(!std::is_copy_constructible_v<ProjectData> &&
+                  !std::is_copy_constructible_v<DailyData>,
+              "the parsed tree must only ever be moved");
+static_assert(std::is_nothrow_move_constructible_v<ProjectData> &&
+                  std::is_nothrow_move_constructible_v<DailyData>,
+              "vector growth must move, not fail over to copying");
+
 #endif // DOMAIN_MODELS_WORKOUT_ITEM_HPP_
@@ -0,0 +1,116 @@
+// domain/models/workout_log.hpp
+#ifndef DOMAIN_MODELS_WORKOUT_LOG_HPP_
+#define DOMAIN_MODELS_WORKOUT_LOG_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "common/symbol_table.hpp"
+#include "domain/models/workout_item.hpp"
+
+// Receives one completed day at a time from a streaming parse. The day and
+// the memory behind it are only valid for the duration of the call; the
+// symbol table resolves its name/type ids. Returning false stops the parse.
+using DaySink = std::function<bool(DailyData& day, SymbolTable& symbols)>;
+
+/**
+ * @brief The days of one parsed file together with the arena that backs them.
+ *
+ * Every string and vector inside the DailyData tree is allocated from an
+ * arena owned here, so building the tree costs a handful of large
+ * allocations and dropping the log releases all of it at once. Arenas live
+ * behind unique_ptrs so that moving a WorkoutLog keeps the addresses the
+ * nested containers point into stable. Exercise names and types in the tree
+ * are ids into the log's SymbolTable.
+ */
+class WorkoutLog {
+public:
+  using allocator_type = std::pmr::polymorphic_allocator<>;
+
+  static constexpr std::size_t kDefaultArenaBytes = 64 * 1024;
+
+  explicit WorkoutLog(std::size_t initial_arena_bytes = kDefaultArenaBytes) {
+    arenas_.push_back(std::make_unique<Arena>(initial_arena_bytes));
+  }
+
+  WorkoutLog(const WorkoutLog&) = delete;
+  auto operator=(const WorkoutLog&) -> WorkoutLog& = delete;
+  WorkoutLog(WorkoutLog&&) noexcept = default;
+  // Member-wise assignment would release the old arenas before the old days
+  // that still point into them, so the days are replaced first.
+  auto operator=(WorkoutLog&& other) noexcept -> WorkoutLog& {
+    if (this != &other) {
+      days_ = std::move(other.days_);
+      symbols_ = std::move(other.symbols_);
+      arenas_ = std::move(other.arenas_);
+    }
+    return *this;
+  }
+  ~WorkoutLog() = default;
+
+  [[nodiscard]] auto GetAllocator() const -> allocator_type {
+    return allocator_type(&arenas_.front()->pool_);
+  }
+
+  // Starts a new, empty day whose members allocate from this log's arena.
+  auto AddDay() -> DailyData& { return days_.emplace_back(GetAllocator()); }
+
+  // Moves the days of `other` to the end of this log. The days keep
+  // allocating from the arenas of `other`, which this log takes over; their
+  // symbol ids are re-interned into this log's table.
+  auto Append(WorkoutLog&& other) -> void {
+    std::vector<SymbolId> remap(other.symbols_.Size());
+    for (SymbolId id = 0; id < remap.size(); ++id) {
+      remap[id] = symbols_.Intern(other.symbols_.Resolve(id));
+    }
+
+    days_.reserve(days_.size() + other.days_.size());
+    for (DailyData& day : other.days_) {
+      for (ProjectData& project : day.projects_) {
+        project.project_name_id_ = remap[project.project_name_id_];
+        project.short_name_id_ = remap[project.short_name_id_];
+        project.type_id_ = remap[project.type_id_];
+      }
+      days_.push_back(std::move(day));
+    }
+    other.days_.clear();
+
+    for (auto& arena : other.arenas_) {
+      arenas_.push_back(std::move(arena));
+    }
+    other.arenas_.clear();
+  }
+
+  [[nodiscard]] auto Symbols() -> SymbolTable& { return symbols_; }
+  [[nodiscard]] auto Symbols() const -> const SymbolTable& { return symbols_; }
+
+  [[nodiscard]] auto Days() -> std::vector<DailyData>& { return days_; }
+  [[nodiscard]] auto Days() const -> const std::vector<DailyData>& {
+    return days_;
+  }
+
+private:
+  // Set and project vectors grow one push_back at a time. A bare monotonic
+  // buffer would strand every outgrown block, so a pool sits on top of it and
+  // recycles them by size class; neither ever returns memory to the heap
+  // before the log itself is dropped.
+  struct Arena {
+    explicit Arena(std::size_t initial_bytes)
+        : buffer_(initial_bytes), pool_(&buffer_) {}
+
+    std::pmr::monotonic_buffer_resource buffer_;
+    std::pmr::unsynchronized_pool_resource pool_;
+  };
+
+  // Declared before days_ so that the days are destroyed first. The front
+  // arena serves new allocations; the rest were adopted through Append().
+  std::vector<std::unique_ptr<Arena>> arenas_;
+  std::vector<DailyData> days_;
+  SymbolTable symbols_;
+};
+
+#endif // DOMAIN_MODELS_WORKOUT_LOG_HPP_
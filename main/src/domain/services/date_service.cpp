@@ -1,13 +1,64 @@
 // domain/services/date_service.cpp
 #include "domain/services/date_service.hpp"
 
+#include <array>
+#include <charconv>
+#include <cstdio>
+
 auto DateService::CompleteDates(std::vector<DailyData>& all_data,
-                                int year_to_use) -> void {
+                                int year_to_use) -> bool {
   for (auto& daily : all_data) {
-    if (daily.date_.length() == 4) {  // Only process "MMDD" format
-      std::string month = daily.date_.substr(0, 2);
-      std::string day = daily.date_.substr(2, 2);
-      daily.date_ = std::to_string(year_to_use) + "-" + month + "-" + day;
+    if (!CompleteDate(daily, year_to_use)) {
+      return false;
     }
   }
+  return true;
+}
+
+auto DateService::CompleteDate(DailyData& daily, int year_to_use) -> bool {
+  const std::chrono::year_month_day kDate =
+      std::chrono::year{year_to_use} / daily.month_day_;
+  if (!kDate.ok()) {
+    return false;
+  }
+  daily.date_ = std::chrono::sys_days{kDate};
+  return true;
+}
+
+auto DateService::Format(std::chrono::sys_days date) -> std::string {
+  const std::chrono::year_month_day kDate{date};
+  std::array<char, 16> buffer{};
+  std::snprintf(buffer.data(), buffer.size(), "%04d-%02u-%02u",
+                static_cast<int>(kDate.year()),
+                static_cast<unsigned>(kDate.month()),
+                static_cast<unsigned>(kDate.day()));
+  return buffer.data();
+}
+
+auto DateService::Parse(std::string_view text)
+    -> std::optional<std::chrono::sys_days> {
+  constexpr size_t kLength = 10;  // YYYY-MM-DD
+  if (text.size() != kLength || text[4] != '-' || text[7] != '-') {
+    return std::nullopt;
+  }
+  auto read_field = [&](size_t pos, size_t length, unsigned& value) -> bool {
+    const char* const kBegin = text.data() + pos;
+    const char* const kEnd = kBegin + length;
+    auto [end, ec] = std::from_chars(kBegin, kEnd, value);
+    return ec == std::errc() && end == kEnd;
+  };
+  unsigned year = 0;
+  unsigned month = 0;
+  unsigned day = 0;
+  if (!read_field(0, 4, year) || !read_field(5, 2, month) ||
+      !read_field(8, 2, day)) {
+    return std::nullopt;
+  }
+  const std::chrono::year_month_day kDate{
+      std::chrono::year{static_cast<int>(year)}, std::chrono::month{month},
+      std::chrono::day{day}};
+  if (!kDate.ok()) {
+    return std::nullopt;
+  }
+  return std::chrono::sys_days{kDate};
 }
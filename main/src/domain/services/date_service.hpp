@@ -3,17 +3,47 @@
 #define DOMAIN_SERVICES_DATE_SERVICE_HPP_
 
 #include "domain/models/workout_item.hpp"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
-// Domain Service for date processing
+// Domain Service for date processing.
+// Dates are std::chrono::sys_days (days since 1970-01-01) everywhere inside
+// the program and INTEGER in the database; the "YYYY-MM-DD" text form only
+// exists at the edges (JSON, reports, CLI arguments).
 class DateService {
 public:
   /**
-   * @brief Complete the year for data and format as YYYY-MM-DD.
+   * @brief Complete the year of every day's MMDD into its date.
    * @param all_data Reference to data to process.
    * @param year_to_use The 4-digit year to apply.
+   * @return false if a day does not exist in that year (Feb 29).
    */
-  static auto CompleteDates(std::vector<DailyData>& all_data, int year_to_use) -> void;
+  [[nodiscard]] static auto CompleteDates(std::vector<DailyData>& all_data,
+                                          int year_to_use) -> bool;
+
+  // Single-day variant used when days are streamed one at a time.
+  [[nodiscard]] static auto CompleteDate(DailyData& daily, int year_to_use)
+      -> bool;
+
+  // Day numbers as stored in the database
+  [[nodiscard]] static auto ToDayNumber(std::chrono::sys_days date)
+      -> std::int64_t {
+    return date.time_since_epoch().count();
+  }
+  [[nodiscard]] static auto FromDayNumber(std::int64_t day_number)
+      -> std::chrono::sys_days {
+    return std::chrono::sys_days{std::chrono::days{day_number}};
+  }
+
+  // "YYYY-MM-DD"
+  [[nodiscard]] static auto Format(std::chrono::sys_days date) -> std::string;
+  // Accepts exactly "YYYY-MM-DD" naming a real calendar day
+  [[nodiscard]] static auto Parse(std::string_view text)
+      -> std::optional<std::chrono::sys_days>;
 };
 
 #endif // DOMAIN_SERVICES_DATE_SERVICE_HPP_
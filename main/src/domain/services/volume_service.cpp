@@ -1,22 +1,33 @@
 // domain/services/volume_service.cpp
 #include "domain/services/volume_service.hpp"
 
-#include <numeric>
-
-auto VolumeService::CalculateProjectVolume(std::vector<SetData>& sets)
-    -> double {
-  double total_volume = 0.0;
-
-  for (auto& set_item : sets) {
-    // If weight is negative (e.g., resistance band assistance), do not count
-    // volume
-    if (set_item.weight_ < 0) {
-      set_item.volume_ = 0.0;
-      continue;
-    }
-
-    set_item.volume_ = set_item.weight_ * set_item.reps_;
-    total_volume += set_item.volume_;
+#include <cstdint>
+#include <limits>
+
+namespace {
+
+// Volumes are never negative; a total that would overflow stops at the limit
+// instead of wrapping around.
+auto AddRunVolume(Weight::GramReps total, Weight::GramReps set_volume,
+                  std::uint16_t count) -> Weight::GramReps {
+  constexpr Weight::GramReps kMax =
+      std::numeric_limits<Weight::GramReps>::max();
+  if (set_volume != 0 && count > (kMax - total) / set_volume) {
+    return kMax;
+  }
+  return total + set_volume * count;
+}
+
+}  // namespace
+
+auto VolumeService::CalculateProjectVolume(
+    const std::pmr::vector<SetData>& sets) -> Weight::GramReps {
+  Weight::GramReps total_volume = 0;
+
+  for (const auto& run : sets) {
+    // If weight is negative (e.g., resistance band assistance), Volume() is 0.
+    // Integer gram-reps are exact, so a run is simply volume x count.
+    total_volume = AddRunVolume(total_volume, run.Volume(), run.count_);
   }
 
   return total_volume;
@@ -24,9 +35,13 @@ auto VolumeService::CalculateProjectVolume(std::vector<SetData>& sets)
 
 auto VolumeService::CalculateVolume(std::vector<DailyData>& all_data) -> void {
   for (auto& daily_data : all_data) {
-    for (auto& project : daily_data.projects_) {
-      // Delegate to helper for calculation
-      project.total_volume_ = CalculateProjectVolume(project.sets_);
-    }
+    CalculateDailyVolume(daily_data);
+  }
+}
+
+auto VolumeService::CalculateDailyVolume(DailyData& daily_data) -> void {
+  for (auto& project : daily_data.projects_) {
+    // Delegate to helper for calculation
+    project.total_volume_g_ = CalculateProjectVolume(project.sets_);
   }
 }
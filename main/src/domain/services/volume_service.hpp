@@ -11,9 +11,13 @@ public:
   // Calculate volume for all items
   static auto CalculateVolume(std::vector<DailyData>& all_data) -> void;
 
+  // Calculate volume for the projects of a single day
+  static auto CalculateDailyVolume(DailyData& daily_data) -> void;
+
 private:
-  // Helper: Calculate volume for a single project
-  static auto CalculateProjectVolume(std::vector<SetData>& sets) -> double;
+  // Helper: Calculate volume for a single project, in gram-reps
+  static auto CalculateProjectVolume(const std::pmr::vector<SetData>& sets)
+      -> Weight::GramReps;
 };
 
 #endif // DOMAIN_SERVICES_VOLUME_SERVICE_HPP_
@@ -0,0 +1,226 @@
+// infrastructure/config/embedded_mapping.cpp
+
+#include "infrastructure/config/embedded_mapping.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace embedded_mapping {
+
+namespace {
+
+// kMappings, kTitles and kFileData, generated at build time from
+// config/mapping.json.
+#include "embedded_mapping_data.inc"
+
+inline constexpr std::size_t kMappingCount = kMappings.size();
+
+// FNV-1a from a salted offset basis, with a final mix so that the high bits
+// depend on every byte.
+constexpr auto Hash(std::string_view key, std::uint32_t salt)
+    -> std::uint64_t {
+  std::uint64_t hash = 14695981039346656037ULL ^ (salt * 0x9E3779B97F4A7C15ULL);
+  for (const char kChar : key) {
+    hash ^= static_cast<unsigned char>(kChar);
+    hash *= 1099511628211ULL;
+  }
+  hash ^= hash >> 31;
+  hash *= 0xBF58476D1CE4E5B9ULL;
+  hash ^= hash >> 29;
+  return hash;
+}
+
+// Hash and displace. One hash of the key picks its bucket and two numbers
+// h1 and h2; the key then lives in slot (h1 + d0 * h2 + d1) % kSlots, where
+// the displacement (d0, d1) is chosen per bucket so that all keys of the
+// bucket land in free slots. If two keys of a bucket share h1 and h2, no
+// displacement separates them and the table is built again with another
+// salt. A lookup is one hash and one string comparison.
+struct PerfectHash {
+  static constexpr std::size_t kBuckets = kMappingCount / 2 + 1;
+  // A little slack keeps the search short for the last, nearly full slots.
+  static constexpr std::size_t kSlots = kMappingCount + kMappingCount / 4 + 1;
+  static constexpr std::uint32_t kMaxSalts = 64;
+
+  std::uint32_t salt_ = 0;
+  // Per bucket, d0 * kSlots + d1.
+  std::array<std::uint32_t, kBuckets> seeds_{};
+  // Slot -> index in kMappings; empty slots point at entry 0, which the
+  // final comparison rejects.
+  std::array<std::uint32_t, kSlots> entries_{};
+
+  struct Hashes {
+    std::size_t bucket_;
+    std::size_t h1_;
+    std::size_t h2_;
+  };
+  [[nodiscard]] static constexpr auto Split(std::uint64_t hash) -> Hashes {
+    return {.bucket_ = static_cast<std::size_t>(hash % kBuckets),
+            .h1_ = static_cast<std::size_t>((hash >> 20) % kSlots),
+            .h2_ = static_cast<std::size_t>((hash >> 42) % (kSlots - 1)) + 1};
+  }
+  [[nodiscard]] static constexpr auto Slot(const Hashes& hashes,
+                                           std::uint32_t seed) -> std::size_t {
+    return (hashes.h1_ + (seed / kSlots) * hashes.h2_ + seed % kSlots) %
+           kSlots;
+  }
+};
+
+static_assert(PerfectHash::kSlots <= UINT16_MAX,
+              "the mapping is too large to embed");
+
+// False if this salt does not work out. Plain arrays and loops keep the
+// constant evaluation well within the compilers' step limits.
+consteval auto TryBuildPerfectHash(PerfectHash& table) -> bool {
+  constexpr std::size_t kBuckets = PerfectHash::kBuckets;
+  constexpr std::size_t kSlots = PerfectHash::kSlots;
+  std::array<PerfectHash::Hashes, kMappingCount> hashes{};
+  for (std::size_t index = 0; index < kMappingCount; ++index) {
+    hashes[index] =
+        PerfectHash::Split(Hash(kMappings[index].short_name_, table.salt_));
+  }
+
+  // The keys of each bucket, contiguous: bucket b owns
+  // members[begins[b] .. begins[b + 1]).
+  std::array<std::uint32_t, kBuckets + 1> begins{};
+  for (const PerfectHash::Hashes& key : hashes) {
+    ++begins[key.bucket_ + 1];
+  }
+  std::uint32_t largest = 0;
+  for (std::size_t bucket = 0; bucket < kBuckets; ++bucket) {
+    largest = std::max(largest, begins[bucket + 1]);
+    begins[bucket + 1] += begins[bucket];
+  }
+  std::array<std::uint32_t, kMappingCount> members{};
+  std::array<std::uint32_t, kBuckets + 1> filled = begins;
+  for (std::uint32_t index = 0; index < kMappingCount; ++index) {
+    members[filled[hashes[index].bucket_]++] = index;
+  }
+
+  for (std::size_t bucket = 0; bucket < kBuckets; ++bucket) {
+    for (std::uint32_t a = begins[bucket]; a < begins[bucket + 1]; ++a) {
+      for (std::uint32_t b = a + 1; b < begins[bucket + 1]; ++b) {
+        const PerfectHash::Hashes& key_a = hashes[members[a]];
+        const PerfectHash::Hashes& key_b = hashes[members[b]];
+        if (key_a.h1_ == key_b.h1_ && key_a.h2_ == key_b.h2_) {
+          return false;
+        }
+      }
+    }
+  }
+
+  // Largest buckets first, while most slots are still free.
+  std::array<std::uint32_t, kBuckets> order{};
+  std::size_t ordered = 0;
+  for (std::uint32_t size = largest; size > 0; --size) {
+    for (std::uint32_t bucket = 0; bucket < kBuckets; ++bucket) {
+      if (begins[bucket + 1] - begins[bucket] == size) {
+        order[ordered++] = bucket;
+      }
+    }
+  }
+
+  std::array<bool, kSlots> taken{};
+  std::array<std::size_t, kMappingCount> slots{};
+  for (std::size_t next = 0; next < ordered; ++next) {
+    const std::uint32_t kBucket = order[next];
+    const std::uint32_t kBegin = begins[kBucket];
+    const std::uint32_t kSize = begins[kBucket + 1] - kBegin;
+    std::uint32_t seed = 0;
+    for (std::uint32_t placed = 0; placed < kSize;) {
+      const std::size_t kSlot =
+          PerfectHash::Slot(hashes[members[kBegin + placed]], seed);
+      bool free = !taken[kSlot];
+      for (std::uint32_t other = 0; other < placed && free; ++other) {
+        free = slots[other] != kSlot;
+      }
+      if (free) {
+        slots[placed++] = kSlot;
+      } else if (++seed == kSlots * kSlots) {
+        return false;
+      } else {
+        placed = 0;
+      }
+    }
+    table.seeds_[kBucket] = seed;
+    for (std::uint32_t member = 0; member < kSize; ++member) {
+      taken[slots[member]] = true;
+      table.entries_[slots[member]] = members[kBegin + member];
+    }
+  }
+  return true;
+}
+
+consteval auto BuildPerfectHash() -> PerfectHash {
+  for (std::uint32_t salt = 0; salt < PerfectHash::kMaxSalts; ++salt) {
+    PerfectHash table;
+    table.salt_ = salt;
+    if (TryBuildPerfectHash(table)) {
+      return table;
+    }
+  }
+  // Equal keys collide under every salt.
+  throw "embedded mapping: no perfect hash (short name listed twice?)";
+}
+
+inline constexpr PerfectHash kPerfectHash = BuildPerfectHash();
+
+constexpr auto Lookup(std::string_view short_name) -> const EmbeddedMapping* {
+  if constexpr (kMappingCount == 0) {
+    return nullptr;
+  } else {
+    const PerfectHash::Hashes kHashes =
+        PerfectHash::Split(Hash(short_name, kPerfectHash.salt_));
+    const std::size_t kSlot =
+        PerfectHash::Slot(kHashes, kPerfectHash.seeds_[kHashes.bucket_]);
+    const EmbeddedMapping& mapping = kMappings[kPerfectHash.entries_[kSlot]];
+    return mapping.short_name_ == short_name ? &mapping : nullptr;
+  }
+}
+
+static_assert(std::ranges::all_of(kMappings,
+                                  [](const EmbeddedMapping& mapping) -> bool {
+                                    return Lookup(mapping.short_name_) ==
+                                           &mapping;
+                                  }));
+
+}  // namespace
+
+auto Find(std::string_view short_name) -> const EmbeddedMapping* {
+  return Lookup(short_name);
+}
+
+auto Mappings() -> std::span<const EmbeddedMapping> { return kMappings; }
+
+auto Titles() -> std::span<const std::string_view> { return kTitles; }
+
+auto CheckFile(const std::string& path) -> FileStatus {
+  std::error_code error;
+  if (!std::filesystem::exists(path, error) && !error) {
+    return FileStatus::kMissing;
+  }
+  const std::uintmax_t kSize = std::filesystem::file_size(path, error);
+  if (error || kSize != kFileData.size()) {
+    return FileStatus::kChanged;
+  }
+
+  std::ifstream file(path, std::ios::binary);
+  std::string content(kFileData.size(), '\0');
+  if (!file.read(content.data(),
+                 static_cast<std::streamsize>(content.size()))) {
+    return FileStatus::kChanged;
+  }
+  return std::ranges::equal(content, kFileData,
+                            [](char byte, unsigned char expected) -> bool {
+                              return static_cast<unsigned char>(byte) ==
+                                     expected;
+                            })
+             ? FileStatus::kUnchanged
+             : FileStatus::kChanged;
+}
+
+}  // namespace embedded_mapping
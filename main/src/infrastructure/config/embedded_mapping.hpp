@@ -0,0 +1,45 @@
+// infrastructure/config/embedded_mapping.hpp
+
+#ifndef INFRASTRUCTURE_CONFIG_EMBEDDED_MAPPING_HPP_
+#define INFRASTRUCTURE_CONFIG_EMBEDDED_MAPPING_HPP_
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+// The mapping the program was built with. The build compiles
+// config/mapping.json (see src/tools/embed_mapping.cpp) into constant tables
+// and a perfect hash over the short names, so a run whose mapping file is
+// missing or unchanged needs no JSON parsing at all. An edited mapping.json
+// next to the executable still takes precedence.
+namespace embedded_mapping {
+
+struct EmbeddedMapping {
+  std::string_view short_name_;
+  std::string_view full_name_;
+  std::string_view type_;
+};
+
+// The mapping for `short_name`, or nullptr if the built-in mapping has none.
+[[nodiscard]] auto Find(std::string_view short_name) -> const EmbeddedMapping*;
+
+// Every mapping, in file order.
+[[nodiscard]] auto Mappings() -> std::span<const EmbeddedMapping>;
+
+// Every key of the built-in mapping, as the validator accepts them.
+[[nodiscard]] auto Titles() -> std::span<const std::string_view>;
+
+enum class FileStatus : std::uint8_t {
+  kMissing,    // no mapping file: the built-in mapping applies
+  kUnchanged,  // byte for byte the file the program was built with
+  kChanged     // edited since the build; it has to be parsed
+};
+
+// Compares the mapping file at `path` with the built-in one. The file is
+// read only when its size matches.
+[[nodiscard]] auto CheckFile(const std::string& path) -> FileStatus;
+
+}  // namespace embedded_mapping
+
+#endif // INFRASTRUCTURE_CONFIG_EMBEDDED_MAPPING_HPP_
@@ -1,54 +1,72 @@
 // converter/converter.cpp
 #include "infrastructure/converter/converter.hpp"
 
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <utility>
 
 #include "domain/services/date_service.hpp"
 #include "domain/services/volume_service.hpp"
 
-Converter::Converter(ILogParser& parser, IMappingProvider& mapping_provider)
-    : parser_(parser), mapping_provider_(mapping_provider) {}
+Converter::Converter(const ILogParser& parser)
+    : parser_(parser), mapper_(std::make_shared<const ProjectNameMapper>()) {}
 
-auto Converter::Configure(const std::string& mapping_file_path) -> bool {
-  auto json_data_opt = mapping_provider_.GetMappingData(mapping_file_path);
-  if (!json_data_opt.has_value()) {
-    std::cerr << "Error: [Converter] Failed to read or parse mapping file: "
-              << mapping_file_path << std::endl;
-    return false;
-  }
+auto Converter::Configure(std::shared_ptr<const ProjectNameMapper> mapper)
+    -> void {
+  mapper_ = std::move(mapper);
+}
 
-  if (!mapper_.LoadMappings(json_data_opt.value().get())) {
-    std::cerr << "Error: [Converter] Failed to load mappings from JSON data."
-              << std::endl;
-    return false;
+auto Converter::MapProjectNames(WorkoutLog& log,
+                                const ProjectNameMapper& mapper) -> void {
+  NameMapCache cache;
+  for (auto& daily_data : log.Days()) {
+    MapProjectNames(daily_data, log.Symbols(), mapper, cache);
   }
-
-  std::cout << "[Converter] Configuration successful. Mappings loaded from "
-            << mapping_file_path << std::endl;
-  return true;
 }
 
-auto Converter::MapProjectNames(std::vector<DailyData>& data) -> void {
-  for (auto& daily_data : data) {
-    for (auto& project : daily_data.projects_) {
-      ProjectMapping mapping = mapper_.GetMapping(project.project_name_);
-      project.project_name_ = mapping.full_name;
-      project.type_ = mapping.type;
+auto Converter::MapProjectNames(DailyData& daily_data, SymbolTable& symbols,
+                                const ProjectNameMapper& mapper,
+                                NameMapCache& cache) -> void {
+  constexpr SymbolId kUnmapped = UINT32_MAX;
+  for (auto& project : daily_data.projects_) {
+    const SymbolId kShortName = project.project_name_id_;
+    if (kShortName >= cache.full_name_ids_.size()) {
+      cache.full_name_ids_.resize(symbols.Size(), kUnmapped);
+      cache.type_ids_.resize(symbols.Size(), kUnmapped);
+    }
+    if (cache.full_name_ids_[kShortName] == kUnmapped) {
+      // Views into the mapper or, for unknown names, into the table itself;
+      // interning never moves the strings already stored.
+      const ProjectMappingView kMapping =
+          mapper.GetMapping(symbols.Resolve(kShortName));
+      cache.full_name_ids_[kShortName] = symbols.Intern(kMapping.full_name);
+      cache.type_ids_[kShortName] = symbols.Intern(kMapping.type);
     }
+    project.project_name_id_ = cache.full_name_ids_[kShortName];
+    project.type_id_ = cache.type_ids_[kShortName];
   }
 }
 
-auto Converter::Convert(const std::string& log_file_path)
-    -> std::optional<std::vector<DailyData>> {
-  if (!parser_.ParseFile(log_file_path)) {
-    std::cerr << "Error: [Converter] Parsing log file failed." << std::endl;
+auto Converter::Convert(const std::string& log_file_path,
+                        ILineCheck& validation) const
+    -> std::optional<WorkoutLog> {
+  const std::shared_ptr<const ProjectNameMapper> kMapper = mapper_;
+  ParseResult parsed = parser_.ParseFile(log_file_path, validation);
+  std::cerr << parsed.diagnostics_;
+  if (!parsed.success_) {
+    // Validation errors have already been reported line by line.
+    if (validation.Passed()) {
+      std::cerr << "Error: [Converter] Parsing log file failed." << std::endl;
+    }
     return std::nullopt;
   }
 
-  auto processed_data = parser_.GetParsedData();
-  auto year_to_use_opt = parser_.GetParsedYear();
+  // Take ownership instead of copying: the days and their arena move as one.
+  WorkoutLog processed_log = std::move(parsed.log_);
+  auto& processed_data = processed_log.Days();
 
-  if (!year_to_use_opt.has_value()) {
+  if (!parsed.year_.has_value()) {
     std::cerr
         << "Error: [Converter] Year could not be determined from the log file."
         << std::endl;
@@ -56,12 +74,73 @@ auto Converter::Convert(const std::string& log_file_path)
   }
 
   if (processed_data.empty()) {
-    return processed_data;
+    return processed_log;
   }
 
-  DateService::CompleteDates(processed_data, year_to_use_opt.value());
+  if (!DateService::CompleteDates(processed_data, parsed.year_.value())) {
+    // Month and day were checked by the parser; only Feb 29 can still fail.
+    std::cerr << "Error: [Converter] February 29 does not exist in "
+              << parsed.year_.value() << "." << std::endl;
+    return std::nullopt;
+  }
   VolumeService::CalculateVolume(processed_data);
-  MapProjectNames(processed_data);
+  MapProjectNames(processed_log, *kMapper);
+
+  return processed_log;
+}
+
+auto Converter::ConvertStreaming(const std::string& log_file_path,
+                                 const DaySink& sink, ILineCheck& validation,
+                                 StreamResume& resume) const -> bool {
+  const std::shared_ptr<const ProjectNameMapper> kMapper = mapper_;
+  NameMapCache cache;
+  bool year_missing = false;
+  std::optional<int> invalid_date_year;
+  bool sink_stopped = false;
+
+  const ParsedDaySink kCompleteDay = [&](DailyData& daily,
+                                         SymbolTable& symbols,
+                                         std::optional<int> year) -> bool {
+    // The year header precedes the first date in any valid log.
+    if (!year.has_value()) {
+      year_missing = true;
+      return false;
+    }
+    if (!DateService::CompleteDate(daily, year.value())) {
+      invalid_date_year = year;
+      return false;
+    }
+    VolumeService::CalculateDailyVolume(daily);
+    MapProjectNames(daily, symbols, *kMapper, cache);
+    sink_stopped = !sink(daily, symbols);
+    return !sink_stopped;
+  };
+  const ParseResult kParsed =
+      resume.from_.has_value()
+          ? parser_.ParseFileStreaming(log_file_path, kCompleteDay,
+                                       validation, resume.from_.value())
+          : parser_.ParseFileStreaming(log_file_path, kCompleteDay,
+                                       validation);
+  std::cerr << kParsed.diagnostics_;
+  resume.stale_ = kParsed.stale_checkpoint_;
+  resume.next_ = kParsed.checkpoint_;
+  if (resume.stale_) {
+    return false;
+  }
 
-  return processed_data;
-}
\ No newline at end of file
+  if (year_missing || (kParsed.success_ && !kParsed.year_.has_value())) {
+    std::cerr
+        << "Error: [Converter] Year could not be determined from the log file."
+        << std::endl;
+    return false;
+  }
+  if (invalid_date_year.has_value()) {
+    std::cerr << "Error: [Converter] February 29 does not exist in "
+              << invalid_date_year.value() << "." << std::endl;
+    return false;
+  }
+  if (!kParsed.success_ && !sink_stopped && validation.Passed()) {
+    std::cerr << "Error: [Converter] Parsing log file failed." << std::endl;
+  }
+  return kParsed.success_;
+}
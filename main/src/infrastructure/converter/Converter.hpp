@@ -4,28 +4,57 @@
 #define CONVERTER_CONVERTER_HPP_
 
 #include "application/interfaces/i_log_parser.hpp"
-#include "application/interfaces/i_mapping_provider.hpp"
 #include "domain/models/workout_item.hpp"
+#include "domain/models/workout_log.hpp"
 #include "infrastructure/converter/log_parser.hpp"
 #include "infrastructure/converter/project_name_mapper.hpp"
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
+// Converts log files into completed WorkoutLogs. Once configured, a
+// Converter is immutable: Convert() and ConvertStreaming() are const and keep
+// all per-file state on the stack, so any number of threads may convert
+// different files through one instance without locking.
 class Converter {
 public:
-  Converter(ILogParser& parser, IMappingProvider& mapping_provider);
+  explicit Converter(const ILogParser& parser);
   
-  auto Configure(const std::string& mapping_file_path) -> bool;
+  // Switches to a new, immutable mapping snapshot. Call it before the
+  // converter is shared between threads; it is the only member that writes.
+  auto Configure(std::shared_ptr<const ProjectNameMapper> mapper) -> void;
   
-  auto Convert(const std::string& log_file_path) -> std::optional<std::vector<DailyData>>;
+  // Validates the file through `validation` while parsing it, in a single
+  // read. Nothing is returned unless the file passes.
+  auto Convert(const std::string& log_file_path, ILineCheck& validation) const
+      -> std::optional<WorkoutLog>;
+
+  // Same processing as Convert(), but each day is completed, measured and
+  // mapped as soon as the parser closes it, then handed to `sink`. Days may
+  // reach the sink before a later line fails validation. With resume.from_
+  // set, only the days from that checkpoint on are produced; resume.next_
+  // receives the checkpoint for the following run.
+  auto ConvertStreaming(const std::string& log_file_path, const DaySink& sink,
+                        ILineCheck& validation, StreamResume& resume) const
+      -> bool;
 
 private:
-  ILogParser& parser_;
-  IMappingProvider& mapping_provider_;
-  ProjectNameMapper mapper_;
+  const ILogParser& parser_;
+  std::shared_ptr<const ProjectNameMapper> mapper_;
+
+  // Short-name id -> mapped full-name/type ids, filled on first use so every
+  // distinct short name is looked up once per conversion.
+  struct NameMapCache {
+    std::vector<SymbolId> full_name_ids_;
+    std::vector<SymbolId> type_ids_;
+  };
 
-  auto MapProjectNames(std::vector<DailyData>& data) -> void;
+  static auto MapProjectNames(WorkoutLog& log, const ProjectNameMapper& mapper)
+      -> void;
+  static auto MapProjectNames(DailyData& daily_data, SymbolTable& symbols,
+                              const ProjectNameMapper& mapper,
+                              NameMapCache& cache) -> void;
 };
 
 #endif // CONVERTER_CONVERTER_HPP_
\ No newline at end of file
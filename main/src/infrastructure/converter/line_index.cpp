@@ -0,0 +1,203 @@
+// converter/line_index.cpp
+
+#include "infrastructure/converter/line_index.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define LINE_INDEX_HAS_SSE2 1
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LINE_INDEX_HAS_AVX2_DISPATCH 1
+#endif
+
+namespace {
+
+auto IsSpace(char value) -> bool {
+  return value == ' ' || value == '\t' || value == '\n' || value == '\r';
+}
+
+// Receives the positions of structural bytes ('\n', '/', '#', ';') in
+// ascending order and turns them into LineRecords.
+class IndexBuilder {
+public:
+  IndexBuilder(std::string_view buffer, std::vector<LineRecord>& records)
+      : buffer_(buffer), records_(records) {}
+
+  auto OnStructural(std::size_t pos) -> void {
+    const char kChar = buffer_[pos];
+    if (kChar == '\n') {
+      EndLine(pos);
+      return;
+    }
+    if (comment_pos_ != std::string_view::npos) {
+      return;
+    }
+    if (kChar == '/') {
+      if (pos + 1 < buffer_.size() && buffer_[pos + 1] == '/') {
+        comment_pos_ = pos;
+      }
+      return;
+    }
+    comment_pos_ = pos;
+  }
+
+  auto Finish() -> void {
+    if (line_start_ < buffer_.size()) {
+      EndLine(buffer_.size());
+    }
+  }
+
+private:
+  auto EndLine(std::size_t line_end) -> void {
+    std::size_t begin = line_start_;
+    std::size_t end = line_end;
+    while (begin < end && IsSpace(buffer_[begin])) {
+      ++begin;
+    }
+    while (end > begin && IsSpace(buffer_[end - 1])) {
+      --end;
+    }
+
+    const std::string_view kLine = buffer_.substr(begin, end - begin);
+    LineRecord record{.begin_ = begin,
+                      .length_ = static_cast<std::uint32_t>(kLine.size()),
+                      .comment_ = LineRecord::kNoComment,
+                      .kind_ = LineIndex::Classify(kLine)};
+    if (comment_pos_ != std::string_view::npos && comment_pos_ < end) {
+      record.comment_ = static_cast<std::uint32_t>(comment_pos_ - begin);
+    }
+    records_.push_back(record);
+
+    line_start_ = line_end + 1;
+    comment_pos_ = std::string_view::npos;
+  }
+
+  std::string_view buffer_;
+  std::vector<LineRecord>& records_;
+  std::size_t line_start_ = 0;
+  std::size_t comment_pos_ = std::string_view::npos;
+};
+
+auto IsStructural(char value) -> bool {
+  return value == '\n' || value == '/' || value == '#' || value == ';';
+}
+
+auto ScanScalar(std::string_view buffer, std::size_t& pos,
+                IndexBuilder& builder) -> void {
+  for (; pos < buffer.size(); ++pos) {
+    if (IsStructural(buffer[pos])) {
+      builder.OnStructural(pos);
+    }
+  }
+}
+
+template <typename MaskType>
+auto EmitMask(MaskType mask, std::size_t base, IndexBuilder& builder)
+    -> void {
+  while (mask != 0) {
+    builder.OnStructural(base + static_cast<std::size_t>(std::countr_zero(mask)));
+    mask &= mask - 1;
+  }
+}
+
+#ifdef LINE_INDEX_HAS_SSE2
+auto ScanSse2(std::string_view buffer, std::size_t& pos, IndexBuilder& builder)
+    -> void {
+  constexpr std::size_t kBlock = 16;
+  const __m128i kNewline = _mm_set1_epi8('\n');
+  const __m128i kSlash = _mm_set1_epi8('/');
+  const __m128i kHash = _mm_set1_epi8('#');
+  const __m128i kSemicolon = _mm_set1_epi8(';');
+
+  for (; pos + kBlock <= buffer.size(); pos += kBlock) {
+    const __m128i kChunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer.data() + pos));
+    const __m128i kHits = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(kChunk, kNewline),
+                     _mm_cmpeq_epi8(kChunk, kSlash)),
+        _mm_or_si128(_mm_cmpeq_epi8(kChunk, kHash),
+                     _mm_cmpeq_epi8(kChunk, kSemicolon)));
+    EmitMask(static_cast<std::uint32_t>(_mm_movemask_epi8(kHits)), pos,
+             builder);
+  }
+}
+#endif
+
+#ifdef LINE_INDEX_HAS_AVX2_DISPATCH
+__attribute__((target("avx2"))) auto ScanAvx2(std::string_view buffer,
+                                              std::size_t& pos,
+                                              IndexBuilder& builder) -> void {
+  constexpr std::size_t kBlock = 32;
+  const __m256i kNewline = _mm256_set1_epi8('\n');
+  const __m256i kSlash = _mm256_set1_epi8('/');
+  const __m256i kHash = _mm256_set1_epi8('#');
+  const __m256i kSemicolon = _mm256_set1_epi8(';');
+
+  for (; pos + kBlock <= buffer.size(); pos += kBlock) {
+    const __m256i kChunk = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(buffer.data() + pos));
+    const __m256i kHits = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(kChunk, kNewline),
+                        _mm256_cmpeq_epi8(kChunk, kSlash)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(kChunk, kHash),
+                        _mm256_cmpeq_epi8(kChunk, kSemicolon)));
+    EmitMask(static_cast<std::uint32_t>(_mm256_movemask_epi8(kHits)), pos,
+             builder);
+  }
+}
+#endif
+
+}  // namespace
+
+auto LineIndex::Build(std::string_view buffer) -> std::vector<LineRecord> {
+  // Log lines are short; reserving for ~24 bytes per line avoids most
+  // regrowth on large files without grossly over-allocating.
+  constexpr std::size_t kAverageLineBytes = 24;
+  std::vector<LineRecord> records;
+  records.reserve(buffer.size() / kAverageLineBytes + 1);
+
+  IndexBuilder builder(buffer, records);
+  std::size_t pos = 0;
+
+#ifdef LINE_INDEX_HAS_AVX2_DISPATCH
+  if (__builtin_cpu_supports("avx2")) {
+    ScanAvx2(buffer, pos, builder);
+  }
+#endif
+#ifdef LINE_INDEX_HAS_SSE2
+  ScanSse2(buffer, pos, builder);
+#endif
+  ScanScalar(buffer, pos, builder);
+
+  builder.Finish();
+  return records;
+}
+
+auto LineIndex::Classify(std::string_view trimmed_line) -> LineKind {
+  if (trimmed_line.empty()) {
+    return LineKind::kBlank;
+  }
+  const char kFirst = trimmed_line[0];
+  if (kFirst == 'y') {
+    return LineKind::kYear;
+  }
+  if (trimmed_line.size() == 4 &&
+      std::ranges::all_of(trimmed_line, [](char value) -> bool {
+        return std::isdigit(static_cast<unsigned char>(value)) != 0;
+      })) {
+    return LineKind::kDate;
+  }
+  if (kFirst == 'r' && trimmed_line.size() >= 2 &&
+      std::isspace(static_cast<unsigned char>(trimmed_line[1])) != 0) {
+    return LineKind::kNote;
+  }
+  if (kFirst == '+' || kFirst == '-') {
+    return LineKind::kContent;
+  }
+  return LineKind::kProject;
+}
@@ -0,0 +1,50 @@
+// converter/line_index.hpp
+
+#ifndef CONVERTER_LINE_INDEX_HPP_
+#define CONVERTER_LINE_INDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+enum class LineKind : std::uint8_t {
+  kBlank,
+  kYear,     // y2025
+  kDate,     // 0105
+  kNote,     // r <text>
+  kContent,  // +60 10+8 / -20 8
+  kProject   // anything else, e.g. bp // note
+};
+
+// One entry per physical line, so the entry position is the line number - 1.
+struct LineRecord {
+  std::size_t begin_;       // offset of the trimmed line in the buffer
+  std::uint32_t length_;    // length of the trimmed line
+  std::uint32_t comment_;   // first "//", '#' or ';' relative to begin_
+  LineKind kind_;
+
+  static constexpr std::uint32_t kNoComment = UINT32_MAX;
+
+  [[nodiscard]] auto Text(std::string_view buffer) const -> std::string_view {
+    return buffer.substr(begin_, length_);
+  }
+};
+
+/**
+ * @brief Structural index of a log buffer.
+ *
+ * A single vectorized pass (AVX2 or SSE2 where available, scalar otherwise)
+ * locates newlines and comment delimiters; each line is then trimmed and
+ * tagged with its LineKind so the parser never rescans the bytes.
+ */
+class LineIndex {
+public:
+  [[nodiscard]] static auto Build(std::string_view buffer)
+      -> std::vector<LineRecord>;
+
+  [[nodiscard]] static auto Classify(std::string_view trimmed_line)
+      -> LineKind;
+};
+
+#endif // CONVERTER_LINE_INDEX_HPP_
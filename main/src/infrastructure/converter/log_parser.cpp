@@ -4,255 +4,703 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <charconv>
 #include <fstream>
 #include <iostream>
-#include <regex>
+#include <iterator>
+#include <optional>
 #include <sstream>
+#include <system_error>
+#include <thread>
 #include <utility>
 
-LogParser::LogParser() = default;
+#include "common/content_hash.hpp"
+#include "common/input_file.hpp"
+#include "common/mapped_file.hpp"
+#include "infrastructure/converter/line_index.hpp"
 
-auto LogParser::GetParsedData() const -> const std::vector<DailyData>& {
-  return all_daily_data_;
-}
+LogParser::LogParser() = default;
 
-auto LogParser::GetParsedYear() const -> std::optional<int> {
-  return parsed_year_;
+auto LogParser::SetWorkerCount(unsigned worker_count) -> void {
+  worker_count_ = worker_count;
 }
 
-auto LogParser::Trim(std::string_view value) -> std::string {
+auto LogParser::Trim(std::string_view value) -> std::string_view {
   const std::string_view kWhitespace = " \t\n\r";
   const size_t kStart = value.find_first_not_of(kWhitespace);
   if (kStart == std::string_view::npos) {
-    return "";
+    return {};
   }
   const size_t kEnd = value.find_last_not_of(kWhitespace);
-  return std::string(value.substr(kStart, kEnd - kStart + 1));
+  return value.substr(kStart, kEnd - kStart + 1);
+}
+
+auto LogParser::SplitComment(std::string_view value, std::uint32_t comment_pos)
+    -> std::pair<std::string_view, std::string_view> {
+  if (comment_pos == LineRecord::kNoComment) {
+    return {Trim(value), {}};
+  }
+  // "//" is the only two-character delimiter; '#' and ';' take one byte.
+  const size_t kNoteStart = comment_pos + (value[comment_pos] == '/' ? 2 : 1);
+  return {Trim(value.substr(0, comment_pos)), Trim(value.substr(kNoteStart))};
+}
+
+auto LogParser::ParseFile(const std::string& file_path) const -> ParseResult {
+  return ParseSource(file_path, nullptr);
 }
 
-auto LogParser::SplitComment(std::string_view value)
-    -> std::pair<std::string, std::string> {
-  const size_t kSlashPos = value.find("//");
-  const size_t kHashPos = value.find('#');
-  const size_t kSemPos = value.find(';');
+auto LogParser::ParseFile(const std::string& file_path, ILineCheck& check) const
+    -> ParseResult {
+  return ParseSource(file_path, &check);
+}
+
+auto LogParser::ParseFileStreaming(const std::string& file_path,
+                                   const ParsedDaySink& sink) const
+    -> ParseResult {
+  return StreamSource(file_path, sink, nullptr, nullptr);
+}
+
+auto LogParser::ParseFileStreaming(const std::string& file_path,
+                                   const ParsedDaySink& sink,
+                                   ILineCheck& check) const -> ParseResult {
+  return StreamSource(file_path, sink, &check, nullptr);
+}
+
+auto LogParser::ParseFileStreaming(const std::string& file_path,
+                                   const ParsedDaySink& sink,
+                                   ILineCheck& check,
+                                   const ParseCheckpoint& from) const
+    -> ParseResult {
+  return StreamSource(file_path, sink, &check, &from);
+}
 
-  auto pick_min = [](size_t first, size_t second) -> size_t {
-    if (first == std::string::npos) {
-      return second;
+auto LogParser::ParseSource(const std::string& file_path,
+                            ILineCheck* check) const -> ParseResult {
+  ParseResult result;
+  std::ostringstream diag;
+
+  MappedFile mapped_file;
+  if (InputFile::IsCompressed(file_path) || InputFile::IsStdin(file_path)) {
+    // Compressed logs and standard input are never held as a whole: blocks
+    // are parsed into the log as they are read.
+    InputFile input;
+    if (input.Open(file_path)) {
+      ParserState state;
+      state.log_ = &result.log_;
+      state.year_ = &result.year_;
+      state.diag_ = &diag;
+      state.check_ = check;
+      bool parsed = ParseStream(input.Stream(), {}, state) && !input.Failed();
+      if (parsed && check != nullptr) {
+        parsed = FinishCheck(state, diag);
+      }
+      result.success_ = parsed;
+    } else {
+      diag << "Error: [LogParser] Could not open file " << file_path
+           << std::endl;
     }
-    if (second == std::string::npos) {
-      return first;
+  } else if (mapped_file.Open(file_path)) {
+    result.success_ = ParseBuffer(mapped_file.View(), check, result, diag);
+  } else {
+    // Sources that cannot be mapped are read into a single buffer instead.
+    std::ifstream file(file_path, std::ios::binary);
+    if (file.is_open()) {
+      const std::string kContent{std::istreambuf_iterator<char>(file),
+                                 std::istreambuf_iterator<char>()};
+      result.success_ = ParseBuffer(kContent, check, result, diag);
+    } else {
+      diag << "Error: [LogParser] Could not open file " << file_path
+           << std::endl;
     }
-    return std::min(first, second);
-  };
+  }
 
-  const size_t kPos = pick_min(kSlashPos, pick_min(kHashPos, kSemPos));
+  result.diagnostics_ = std::move(diag).str();
+  return result;
+}
 
-  std::string main_part(value);
-  std::string note_part;
-  if (kPos != std::string::npos) {
-    main_part = std::string(value.substr(0, kPos));
-    size_t note_start = kPos;
-    if (value.compare(kPos, 2, "//") == 0) {
-      note_start += 2;
-    } else {
-      note_start += 1;
+auto LogParser::StreamSource(const std::string& file_path,
+                             const ParsedDaySink& sink, ILineCheck* check,
+                             const ParseCheckpoint* from) -> ParseResult {
+  ParseResult result;
+  std::ostringstream diag;
+  InputFile input;
+  if (!input.Open(file_path)) {
+    diag << "Error: [LogParser] Could not open file " << file_path
+         << std::endl;
+    result.diagnostics_ = std::move(diag).str();
+    return result;
+  }
+
+  // Days are built in a fixed buffer; release() rewinds to it, so a typical
+  // day never touches the heap and a large one only temporarily.
+  std::vector<std::byte> day_buffer(kDayArenaBytes);
+  std::pmr::monotonic_buffer_resource day_arena(day_buffer.data(),
+                                                day_buffer.size());
+  ParserState state;
+  state.log_ = &result.log_;
+  state.year_ = &result.year_;
+  state.diag_ = &diag;
+  state.sink_ = &sink;
+  state.day_arena_ = &day_arena;
+  state.check_ = check;
+  state.hash_ = ContentHash::kInitial;
+
+  // A resumed parse never seeks, so compressed input can resume as well:
+  // the verified prefix is read through and parsing starts with the part
+  // of it that belongs to the last date line.
+  std::string carry;
+  if (from != nullptr) {
+    if (!VerifyPrefix(input.Stream(), *from, state.hash_, carry)) {
+      result.stale_checkpoint_ = !input.Failed();
+      return result;
+    }
+    result.year_ = from->year_;
+    state.block_offset_ = from->offset_;
+    state.line_counter_ = from->line_count_;
+    state.checked_line_count_ = from->checked_line_count_;
+    state.day_count_ = from->sealed_days_;
+    check->Resume(from->checked_line_count_, from->year_);
+  }
+
+  bool parsed =
+      ParseStream(input.Stream(), std::move(carry), state) && !input.Failed();
+  if (parsed && check != nullptr) {
+    parsed = FinishCheck(state, diag);
+  }
+  result.success_ = parsed && EmitDay(state);
+  if (result.success_) {
+    result.checkpoint_ = state.checkpoint_;
+  }
+  result.diagnostics_ = std::move(diag).str();
+  return result;
+}
+
+auto LogParser::ParseStream(std::istream& input, std::string carry,
+                            ParserState& state) -> bool {
+  std::string block = std::move(carry);
+  std::vector<char> chunk(kStreamBlockBytes);
+  bool parsed = true;
+  while (parsed &&
+         (input.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) ||
+          input.gcount() > 0)) {
+    block.append(chunk.data(), static_cast<size_t>(input.gcount()));
+    const size_t kLastNewline = block.rfind('\n');
+    if (kLastNewline == std::string::npos) {
+      continue;
     }
-    note_part = std::string(value.substr(note_start));
+    const std::string_view kLines =
+        std::string_view(block).substr(0, kLastNewline + 1);
+    parsed = ParseLines(kLines, state);
+    Consume(kLines, state);
+    block.erase(0, kLastNewline + 1);
   }
 
-  return {Trim(main_part), Trim(note_part)};
+  parsed = parsed && ParseLines(block, state);
+  Consume(block, state);
+  return parsed;
+}
+
+auto LogParser::Consume(std::string_view bytes, ParserState& state) -> void {
+  const std::uint64_t kBlockEnd = state.block_offset_ + bytes.size();
+  // The hash up to the end of the latest date line becomes the checkpoint's
+  // prefix hash.
+  if (state.sink_ != nullptr) {
+    if (state.checkpoint_.has_value() &&
+        state.checkpoint_->hashed_bytes_ > state.block_offset_) {
+      const auto kSplit = static_cast<size_t>(
+          state.checkpoint_->hashed_bytes_ - state.block_offset_);
+      state.hash_ = ContentHash::Update(state.hash_, bytes.substr(0, kSplit));
+      state.checkpoint_->prefix_hash_ = state.hash_;
+      bytes.remove_prefix(kSplit);
+    }
+    state.hash_ = ContentHash::Update(state.hash_, bytes);
+  }
+  state.block_offset_ = kBlockEnd;
 }
 
-auto LogParser::IsNoteLine(std::string_view text) -> bool {
-  if (text.size() < 2 || text[0] != 'r') {
+auto LogParser::VerifyPrefix(std::istream& input, const ParseCheckpoint& from,
+                             std::uint64_t& hash, std::string& carry) -> bool {
+  if (from.offset_ > from.hashed_bytes_) {
     return false;
   }
-  return std::isspace(static_cast<unsigned char>(text[1])) != 0;
+  ContentHash::Value prefix_hash = ContentHash::kInitial;
+  hash = ContentHash::kInitial;
+  std::vector<char> chunk(kStreamBlockBytes);
+  std::uint64_t position = 0;
+  while (position < from.hashed_bytes_) {
+    const auto kWanted = static_cast<std::streamsize>(
+        std::min<std::uint64_t>(chunk.size(), from.hashed_bytes_ - position));
+    if (!input.read(chunk.data(), kWanted)) {
+      return false;  // the file is shorter than it was
+    }
+    std::string_view bytes(chunk.data(), static_cast<size_t>(kWanted));
+    if (position + bytes.size() > from.offset_) {
+      size_t split = 0;
+      if (from.offset_ >= position) {
+        split = static_cast<size_t>(from.offset_ - position);
+        hash = ContentHash::Update(prefix_hash, bytes.substr(0, split));
+      }
+      carry.append(bytes.substr(split));
+    }
+    prefix_hash = ContentHash::Update(prefix_hash, bytes);
+    position += bytes.size();
+  }
+  return prefix_hash == from.prefix_hash_;
 }
 
-auto LogParser::ParseFile(const std::string& file_path) -> bool {
-  std::ifstream file(file_path);
-  if (!file.is_open()) {
-    std::cerr << "Error: [LogParser] Could not open file " << file_path
-              << std::endl;
+auto LogParser::FinishCheck(const ParserState& state,
+                            std::ostringstream& diag) -> bool {
+  if (!state.check_->Finish()) {
+    diag.str({});
     return false;
   }
+  return !state.parse_failed_;
+}
+
+auto LogParser::EmitDay(ParserState& state) -> bool {
+  if (!state.stream_day_.has_value()) {
+    return true;
+  }
+  // Streaming keeps no days in the log; only its symbol table is used.
+  const bool kKeepGoing =
+      (*state.sink_)(*state.stream_day_, state.log_->Symbols(), *state.year_);
+  state.stream_day_.reset();
+  state.current_daily_data_ = nullptr;
+  state.current_project_ = nullptr;
+  state.day_arena_->release();
+  return kKeepGoing;
+}
+
+auto LogParser::ParseBuffer(std::string_view buffer, ILineCheck* check,
+                            ParseResult& result, std::ostream& diag) const
+    -> bool {
+  const std::vector<LineRecord> kIndex = LineIndex::Build(buffer);
+
+  // The whole file is checked before any day is built, straight off the
+  // same index, so a file that fails costs no parsing at all.
+  if (check != nullptr) {
+    CheckRecords(buffer, kIndex, *check);
+    if (!check->Finish()) {
+      return false;
+    }
+  }
 
-  all_daily_data_.clear();
-  parsed_year_.reset();
+  const unsigned kWorkers =
+      worker_count_ != 0 ? worker_count_ : std::thread::hardware_concurrency();
+  if (kWorkers > 1 && buffer.size() >= kMinParallelBytes) {
+    return ParseParallel(buffer, kIndex, kWorkers, result, diag);
+  }
 
-  std::string line;
+  // The arena starts at the size of the source text and grows geometrically
+  // from there, so even large files need only a few dozen upstream blocks.
+  result.log_ =
+      WorkoutLog(std::max(buffer.size(), WorkoutLog::kDefaultArenaBytes));
   ParserState state;
+  state.log_ = &result.log_;
+  state.year_ = &result.year_;
+  state.diag_ = &diag;
+  return ParseRecords(buffer, kIndex, state);
+}
 
-  while (std::getline(file, line)) {
-    state.line_counter_++;
-    line = Trim(line);
-    if (line.empty()) {
-      continue;
+auto LogParser::ParseParallel(std::string_view buffer,
+                              std::span<const LineRecord> index,
+                              unsigned worker_count, ParseResult& result,
+                              std::ostream& diag) -> bool {
+  // Every chunk after the first starts at a date line, so each one is a run
+  // of complete days that needs no state from its predecessor. Only the year
+  // header is global; it is resolved in file order below.
+  std::vector<size_t> bounds{0};
+  for (unsigned chunk = 1; chunk < worker_count; ++chunk) {
+    size_t pos = std::max(bounds.back() + 1, index.size() * chunk / worker_count);
+    while (pos < index.size() && index[pos].kind_ != LineKind::kDate) {
+      ++pos;
+    }
+    if (pos >= index.size()) {
+      break;
     }
+    bounds.push_back(pos);
+  }
+  bounds.push_back(index.size());
 
-    bool success = true;
-    if (line[0] == 'y') {
-      success = HandleYearLine(line);
-    } else if (line.length() == 4 && std::ranges::all_of(line, ::isdigit)) {
-      success = HandleDateLine(line, state);
-    } else if (IsNoteLine(line)) {
-      success = HandleNoteLine(line, state);
-    } else if (line[0] == '+' || line[0] == '-') {
-      success = HandleContentLine(line, state);
-    } else {
-      success = HandleProjectLine(line, state);
+  struct Chunk {
+    WorkoutLog log_;
+    std::optional<int> year_;
+    std::ostringstream diag_;
+    bool ok_ = false;
+  };
+  std::vector<Chunk> chunks(bounds.size() - 1);
+
+  auto parse_chunk = [&](size_t chunk_index) -> void {
+    const size_t kBegin = bounds[chunk_index];
+    const size_t kEnd = bounds[chunk_index + 1];
+    Chunk& chunk = chunks[chunk_index];
+    const size_t kTextBytes = kEnd > kBegin
+                                  ? index[kEnd - 1].begin_ +
+                                        index[kEnd - 1].length_ -
+                                        index[kBegin].begin_
+                                  : 0;
+    chunk.log_ =
+        WorkoutLog(std::max(kTextBytes, WorkoutLog::kDefaultArenaBytes));
+
+    ParserState state;
+    state.log_ = &chunk.log_;
+    state.year_ = &chunk.year_;
+    state.diag_ = &chunk.diag_;
+    // Records are one per physical line, so numbering simply resumes here.
+    state.line_counter_ = static_cast<int>(kBegin);
+    chunk.ok_ =
+        ParseRecords(buffer, index.subspan(kBegin, kEnd - kBegin), state);
+  };
+
+  {
+    std::vector<std::jthread> workers;
+    workers.reserve(chunks.size() - 1);
+    for (size_t chunk_index = 1; chunk_index < chunks.size(); ++chunk_index) {
+      workers.emplace_back(parse_chunk, chunk_index);
     }
+    parse_chunk(0);
+  }
 
-    if (!success) {
+  // Replay diagnostics and stitch the days together in file order, stopping
+  // at the first failing chunk exactly as a sequential parse would.
+  for (Chunk& chunk : chunks) {
+    diag << chunk.diag_.str();
+    if (!result.year_.has_value()) {
+      result.year_ = chunk.year_;
+    }
+    if (!chunk.ok_) {
       return false;
     }
+    result.log_.Append(std::move(chunk.log_));
   }
+  return true;
+}
 
-  if (!state.current_daily_data_.date_.empty()) {
-    all_daily_data_.push_back(state.current_daily_data_);
+auto LogParser::ParseLines(std::string_view buffer, ParserState& state)
+    -> bool {
+  const std::vector<LineRecord> kIndex = LineIndex::Build(buffer);
+  if (state.check_ == nullptr) {
+    return ParseRecords(buffer, kIndex, state);
   }
 
-  file.close();
+  // Once the check or the parse has failed, later blocks are only checked so
+  // that every validation error is still reported.
+  CheckRecords(buffer, kIndex, *state.check_);
+  if (!state.check_->Passed()) {
+    state.building_ = false;
+  }
+  if (state.building_ && !ParseRecords(buffer, kIndex, state)) {
+    state.building_ = false;
+    state.parse_failed_ = true;
+  }
   return true;
 }
 
-auto LogParser::HandleYearLine(const std::string& line) -> bool {
-  const std::regex kYearRegex(R"(^y(\d{4})$)");
-  std::smatch match;
-  if (std::regex_match(line, match, kYearRegex)) {
-    if (!parsed_year_.has_value()) {
-      parsed_year_ = std::stoi(match[1].str());
+auto LogParser::CheckRecords(std::string_view buffer,
+                             std::span<const LineRecord> records,
+                             ILineCheck& check) -> void {
+  for (const LineRecord& record : records) {
+    if (record.kind_ != LineKind::kBlank) {
+      check.Check(record.Text(buffer));
+    }
+  }
+}
+
+auto LogParser::ParseRecords(std::string_view buffer,
+                             std::span<const LineRecord> records,
+                             ParserState& state) -> bool {
+  for (const LineRecord& record : records) {
+    state.line_counter_++;
+    const std::string_view kLine = record.Text(buffer);
+
+    bool success = true;
+    switch (record.kind_) {
+      case LineKind::kBlank:
+        break;
+      case LineKind::kYear:
+        success = HandleYearLine(kLine, state);
+        break;
+      case LineKind::kDate:
+        MarkCheckpoint(record, state);
+        success = HandleDateLine(kLine, state);
+        break;
+      case LineKind::kNote:
+        success = HandleNoteLine(kLine, state);
+        break;
+      case LineKind::kContent:
+        success = HandleContentLine(kLine, record.comment_, state);
+        break;
+      case LineKind::kProject:
+        success = HandleProjectLine(kLine, record.comment_, state);
+        break;
+    }
+
+    if (!success) {
+      return false;
+    }
+    if (record.kind_ != LineKind::kBlank) {
+      state.checked_line_count_++;
     }
   }
+
+  return true;
+}
+
+auto LogParser::MarkCheckpoint(const LineRecord& record, ParserState& state)
+    -> void {
+  if (state.sink_ == nullptr || !state.year_->has_value()) {
+    return;
+  }
+  // The hashed prefix runs through the date itself, so a file that still
+  // matches is known to continue with the same day.
+  ParseCheckpoint& checkpoint = state.checkpoint_.emplace();
+  checkpoint.offset_ = state.block_offset_ + record.begin_;
+  checkpoint.hashed_bytes_ = checkpoint.offset_ + record.length_;
+  checkpoint.year_ = state.year_->value();
+  checkpoint.line_count_ = state.line_counter_ - 1;
+  checkpoint.checked_line_count_ = state.checked_line_count_;
+  checkpoint.sealed_days_ = state.day_count_;
+}
+
+auto LogParser::HandleYearLine(std::string_view line, ParserState& state)
+    -> bool {
+  // Equivalent to ^y(\d{4})$ without building a regex per line.
+  if (line.size() != 5 ||
+      !std::ranges::all_of(line.substr(1), [](char value) -> bool {
+        return std::isdigit(static_cast<unsigned char>(value)) != 0;
+      })) {
+    return true;
+  }
+  if (!state.year_->has_value()) {
+    int year = 0;
+    std::from_chars(line.data() + 1, line.data() + line.size(), year);
+    *state.year_ = year;
+  }
   return true;
 }
 
-auto LogParser::HandleDateLine(const std::string& line, ParserState& state)
+auto LogParser::HandleDateLine(std::string_view line, ParserState& state)
     -> bool {
-  if (!state.current_daily_data_.date_.empty()) {
-    all_daily_data_.push_back(state.current_daily_data_);
+  // LineIndex only classifies four-digit lines as dates: MMDD
+  auto two_digits = [](std::string_view digits) -> unsigned {
+    return static_cast<unsigned>((digits[0] - '0') * 10 + (digits[1] - '0'));
+  };
+  const std::chrono::month_day kMonthDay{
+      std::chrono::month{two_digits(line.substr(0, 2))},
+      std::chrono::day{two_digits(line.substr(2, 2))}};
+  if (!kMonthDay.ok()) {
+    *state.diag_ << "Error: [LogParser] Invalid date '" << line
+                 << "' at line " << state.line_counter_ << "." << std::endl;
+    return false;
   }
-  state.current_daily_data_ = DailyData();
-  state.current_daily_data_.date_ = line;
+
+  if (state.sink_ != nullptr) {
+    if (!EmitDay(state)) {
+      return false;
+    }
+    state.current_daily_data_ = &state.stream_day_.emplace(
+        DailyData::allocator_type(state.day_arena_));
+  } else {
+    state.current_daily_data_ = &state.log_->AddDay();
+  }
+  state.current_daily_data_->month_day_ = kMonthDay;
   state.current_project_ = nullptr;
+  state.day_count_++;
   return true;
 }
 
-auto LogParser::HandleNoteLine(const std::string& line, ParserState& state)
+auto LogParser::HandleNoteLine(std::string_view line, ParserState& state)
     -> bool {
-  if (state.current_daily_data_.date_.empty()) {
-    std::cerr << "Error: [LogParser] Note found before a date line at line "
+  if (state.current_daily_data_ == nullptr) {
+    *state.diag_ << "Error: [LogParser] Note found before a date line at line "
               << state.line_counter_ << "." << std::endl;
     return false;
   }
-  if (!state.current_daily_data_.projects_.empty()) {
-    std::cerr
+  if (!state.current_daily_data_->projects_.empty()) {
+    *state.diag_
         << "Error: [LogParser] Note must appear before any project at line "
         << state.line_counter_ << "." << std::endl;
     return false;
   }
-  if (!state.current_daily_data_.note_.empty()) {
-    std::cerr << "Error: [LogParser] Duplicate note at line "
+  if (!state.current_daily_data_->note_.empty()) {
+    *state.diag_ << "Error: [LogParser] Duplicate note at line "
               << state.line_counter_ << "." << std::endl;
     return false;
   }
-  std::string note = Trim(line.substr(1));
-  if (note.empty()) {
-    std::cerr << "Error: [LogParser] Empty note at line " << state.line_counter_
+  const std::string_view kNote = Trim(line.substr(1));
+  if (kNote.empty()) {
+    *state.diag_ << "Error: [LogParser] Empty note at line " << state.line_counter_
               << "." << std::endl;
     return false;
   }
-  state.current_daily_data_.note_ = note;
+  state.current_daily_data_->note_ = kNote;
   return true;
 }
 
-auto LogParser::HandleContentLine(const std::string& line, ParserState& state)
-    -> bool {
+auto LogParser::HandleContentLine(std::string_view line,
+                                  std::uint32_t comment_pos,
+                                  ParserState& state) -> bool {
   if (state.current_project_ == nullptr) {
-    std::cerr << "Error: [LogParser] Content line found without a "
+    *state.diag_ << "Error: [LogParser] Content line found without a "
                  "preceding project name at line "
               << state.line_counter_ << "." << std::endl;
     return false;
   }
-  auto [main_part, note_part] = SplitComment(line);
+  auto [main_part, note_part] = SplitComment(line, comment_pos);
   if (main_part.empty()) {
-    std::cerr << "Error: [LogParser] Empty content line at line "
+    *state.diag_ << "Error: [LogParser] Empty content line at line "
               << state.line_counter_ << "." << std::endl;
     return false;
   }
-  double weight = 0.0;
-  std::vector<SetData> parsed_sets = ParseContentLine(main_part, weight);
-  for (auto& set_item : parsed_sets) {
-    set_item.weight_ = weight;
-    set_item.note_ = note_part;
-    set_item.set_number_ =
-        static_cast<int>(state.current_project_->sets_.size()) + 1;
-    state.current_project_->sets_.push_back(set_item);
-  }
+  ParseContentLine(main_part, note_part, *state.current_daily_data_,
+                   *state.current_project_, *state.diag_);
   return true;
 }
 
-auto LogParser::HandleProjectLine(const std::string& line, ParserState& state)
-    -> bool {
-  if (state.current_daily_data_.date_.empty()) {
-    std::cerr << "Error: [LogParser] Project name found before a year/date "
+auto LogParser::HandleProjectLine(std::string_view line,
+                                  std::uint32_t comment_pos,
+                                  ParserState& state) -> bool {
+  if (state.current_daily_data_ == nullptr) {
+    *state.diag_ << "Error: [LogParser] Project name found before a year/date "
                  "line at line "
               << state.line_counter_ << "." << std::endl;
     return false;
   }
-  state.current_daily_data_.projects_.emplace_back();
-  state.current_project_ = &state.current_daily_data_.projects_.back();
-  auto [proj_name, proj_note] = SplitComment(line);
+  state.current_daily_data_->projects_.emplace_back();
+  state.current_project_ = &state.current_daily_data_->projects_.back();
+  auto [proj_name, proj_note] = SplitComment(line, comment_pos);
   if (proj_name.empty()) {
-    std::cerr << "Error: [LogParser] Empty project name at line "
+    *state.diag_ << "Error: [LogParser] Empty project name at line "
               << state.line_counter_ << "." << std::endl;
     return false;
   }
-  state.current_project_->project_name_ = proj_name;
+  state.current_project_->project_name_id_ =
+      state.log_->Symbols().Intern(proj_name);
+  state.current_project_->short_name_id_ =
+      state.current_project_->project_name_id_;
   state.current_project_->note_ = proj_note;
   state.current_project_->line_number_ = state.line_counter_;
   return true;
 }
 
-auto LogParser::ParseContentLine(const std::string& line, double& out_weight)
-    -> std::vector<SetData> {
-  std::vector<SetData> sets;
-  std::stringstream str_stream(line);
-
-  char sign_char;
-  str_stream >> sign_char;
-
-  double val;
-  str_stream >> val;
+auto LogParser::ParseContentLine(std::string_view line,
+                                 std::string_view note, DailyData& day,
+                                 ProjectData& project, std::ostream& diag)
+    -> void {
+  const char* cursor = line.data();
+  const char* const kEnd = line.data() + line.size();
+
+  auto skip_space = [&]() -> void {
+    while (cursor != kEnd &&
+           std::isspace(static_cast<unsigned char>(*cursor)) != 0) {
+      ++cursor;
+    }
+  };
 
-  out_weight = (sign_char == '-') ? -val : val;
+  skip_space();
+  if (cursor == kEnd) {
+    return;
+  }
+  const bool kNegative = (*cursor == '-');
+  ++cursor;
 
-  std::string reps_part;
-  std::getline(str_stream, reps_part);
+  skip_space();
+  if (cursor != kEnd && *cursor == '+') {
+    ++cursor;
+  }
+  double value = 0.0;
+  auto [weight_end, weight_ec] = std::from_chars(cursor, kEnd, value);
+  if (weight_ec != std::errc()) {
+    return;
+  }
+  cursor = weight_end;
 
-  std::string clean_reps;
-  for (char char_item : reps_part) {
-    if (std::isdigit(static_cast<unsigned char>(char_item)) != 0 ||
-        char_item == '+') {
-      clean_reps += char_item;
+  // The weight becomes integer grams here, once. Loads default to kg and
+  // elastic bands (negative weights) to lbs; a "kg"/"lbs" suffix overrides.
+  auto consume_unit = [&](std::string_view unit) -> bool {
+    if (static_cast<size_t>(kEnd - cursor) < unit.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < unit.size(); ++i) {
+      if (std::tolower(static_cast<unsigned char>(cursor[i])) != unit[i]) {
+        return false;
+      }
     }
+    cursor += unit.size();
+    return true;
+  };
+  bool in_lbs = kNegative;
+  if (consume_unit("lbs")) {
+    in_lbs = true;
+  } else if (consume_unit("kg")) {
+    in_lbs = false;
   }
+  const std::optional<Weight::Grams> kGrams =
+      in_lbs ? Weight::FromLbs(value) : Weight::FromKg(value);
+  if (!kGrams.has_value()) {
+    diag << "Warning: Weight out of range in '" << line
+         << "', skipping line." << std::endl;
+    return;
+  }
+  const Weight::Grams kWeight = kNegative ? -*kGrams : *kGrams;
+
+  // Everything after the weight is reduced to digits and '+' separators, so
+  // units ("kg", "lbs") and stray spaces never start a new rep token.
+  // The note is registered once for the whole line, and only when the line
+  // actually produces a set.
+  std::uint16_t note_index = SetData::kNoNote;
+  bool note_registered = false;
+
+  // Digits of a token with other characters between them ("1 0"). A token
+  // whose digits are contiguous, surrounding spaces aside, is parsed where
+  // it stands.
+  std::string scattered_digits;
+
+  auto add_set = [&](std::string_view digits) -> void {
+    int reps = 0;
+    auto [reps_end, reps_ec] =
+        std::from_chars(digits.data(), digits.data() + digits.size(), reps);
+    if (reps_ec != std::errc()) {
+      // Digits only, so the one failure is overflow; the message keeps the
+      // text std::stoi's exception used to print.
+      diag << "Warning: Failed to parse reps from token '" << digits
+           << "': stoi" << std::endl;
+      return;
+    }
+    if (!note_registered) {
+      note_index = day.AddSetNote(note);
+      note_registered = true;
+      if (note_index == SetData::kNoNote && !note.empty()) {
+        diag << "Warning: Too many set notes on one day, dropping note '"
+             << note << "'." << std::endl;
+      }
+    }
+    project.AddSet(kWeight, reps, note_index);
+  };
 
-  std::stringstream reps_ss(clean_reps);
-  std::string rep_token;
-  while (std::getline(reps_ss, rep_token, '+')) {
-    if (!rep_token.empty()) {
-      SetData current_set;
-      try {
-        current_set.reps_ = std::stoi(rep_token);
-        sets.push_back(current_set);
-      } catch (const std::exception& e) {
-        std::cerr << "Warning: Failed to parse reps from token '" << rep_token
-                  << "': " << e.what() << std::endl;
+  auto is_digit = [](char byte) -> bool {
+    return std::isdigit(static_cast<unsigned char>(byte)) != 0;
+  };
+  while (cursor != kEnd) {
+    const char* const kTokenEnd = std::find(cursor, kEnd, '+');
+    const char* const kFirst = std::find_if(cursor, kTokenEnd, is_digit);
+    const char* const kLast =
+        std::find_if(std::make_reverse_iterator(kTokenEnd),
+                     std::make_reverse_iterator(kFirst), is_digit)
+            .base();
+    const std::string_view kDigits(kFirst, static_cast<size_t>(kLast - kFirst));
+    if (std::ranges::all_of(kDigits, is_digit)) {
+      if (!kDigits.empty()) {
+        add_set(kDigits);
       }
+    } else {
+      scattered_digits.clear();
+      std::ranges::copy_if(kDigits, std::back_inserter(scattered_digits),
+                           is_digit);
+      add_set(scattered_digits);
     }
+    cursor = kTokenEnd == kEnd ? kEnd : kTokenEnd + 1;
   }
-  return sets;
 }
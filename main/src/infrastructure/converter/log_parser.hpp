@@ -5,7 +5,14 @@
 
 #include "application/interfaces/i_log_parser.hpp"
 #include "domain/models/workout_item.hpp"
+#include "domain/models/workout_log.hpp"
+#include "infrastructure/converter/line_index.hpp"
+#include <cstdint>
+#include <memory_resource>
 #include <optional>
+#include <ostream>
+#include <sstream>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -14,32 +21,118 @@ class LogParser : public ILogParser {
 public:
   LogParser();
   
-  auto ParseFile(const std::string& file_path) -> bool override;
+  auto ParseFile(const std::string& file_path) const -> ParseResult override;
   
-  auto GetParsedData() const -> const std::vector<DailyData>& override;
+  auto ParseFileStreaming(const std::string& file_path,
+                          const ParsedDaySink& sink) const
+      -> ParseResult override;
 
-  auto GetParsedYear() const -> std::optional<int> override;
+  auto ParseFile(const std::string& file_path, ILineCheck& check) const
+      -> ParseResult override;
+
+  auto ParseFileStreaming(const std::string& file_path,
+                          const ParsedDaySink& sink, ILineCheck& check) const
+      -> ParseResult override;
+
+  auto ParseFileStreaming(const std::string& file_path,
+                          const ParsedDaySink& sink, ILineCheck& check,
+                          const ParseCheckpoint& from) const
+      -> ParseResult override;
+
+  // Number of threads a large in-memory parse may use; 0 (the default)
+  // means one per hardware thread, 1 disables the parallel path. Set it
+  // before the parser is shared.
+  auto SetWorkerCount(unsigned worker_count) -> void;
 
 private:
   struct ParserState {
-    DailyData current_daily_data_;
+    // Where days, symbols and the year go, and where warnings are written.
+    // Everything a parse touches lives here or in the result, never in the
+    // parser, so concurrent parses and parallel chunks share nothing.
+    WorkoutLog* log_ = nullptr;
+    std::optional<int>* year_ = nullptr;
+    std::ostream* diag_ = nullptr;
+
+    DailyData* current_daily_data_ = nullptr;
     ProjectData* current_project_ = nullptr;
     int line_counter_ = 0;
+
+    // Streaming mode only: the open day lives in a per-day arena that is
+    // rewound once the sink has consumed it.
+    const ParsedDaySink* sink_ = nullptr;
+    std::pmr::monotonic_buffer_resource* day_arena_ = nullptr;
+    std::optional<DailyData> stream_day_;
+
+    // Checked streaming only: once the check or the parse has failed no more
+    // days are built, but every line still goes through the check.
+    ILineCheck* check_ = nullptr;
+    bool building_ = true;
+    bool parse_failed_ = false;
+
+    // Streaming only: file offset of the buffer handed to ParseLines(), the
+    // hash of everything before it, the counts a resumed parse continues
+    // from, and the last date line seen.
+    std::uint64_t block_offset_ = 0;
+    std::uint64_t hash_ = 0;
+    int checked_line_count_ = 0;
+    int day_count_ = 0;
+    std::optional<ParseCheckpoint> checkpoint_;
   };
 
-  std::vector<DailyData> all_daily_data_;
-  std::optional<int> parsed_year_;
+  // Streaming reads the file in blocks of this size; only the unfinished
+  // last line of a block is carried over to the next one.
+  static constexpr std::size_t kStreamBlockBytes = 1 << 20;
+  static constexpr std::size_t kDayArenaBytes = 64 * 1024;
+  // Below this size thread start-up and the final stitching outweigh the
+  // gain of splitting the file.
+  static constexpr std::size_t kMinParallelBytes = 4 << 20;
+
+  unsigned worker_count_ = 0;
+
+  [[nodiscard]] auto ParseSource(const std::string& file_path, ILineCheck* check) const -> ParseResult;
+  [[nodiscard]] static auto StreamSource(const std::string& file_path, const ParsedDaySink& sink, ILineCheck* check, const ParseCheckpoint* from) -> ParseResult;
+  // Reads the prefix `from` was taken over and compares its hash. On a
+  // match `hash` holds the hash of everything before from.offset_ and
+  // `carry` the rest of the prefix, i.e. the start of the last date line.
+  [[nodiscard]] static auto VerifyPrefix(std::istream& input, const ParseCheckpoint& from, std::uint64_t& hash, std::string& carry) -> bool;
+  // Reads `input` to the end in blocks and parses them; `carry` is text
+  // already read that precedes the first block.
+  [[nodiscard]] static auto ParseStream(std::istream& input, std::string carry, ParserState& state) -> bool;
+  // Streaming only: adds parsed bytes to the running hash and records it in
+  // the checkpoint once its prefix is complete.
+  static auto Consume(std::string_view bytes, ParserState& state) -> void;
+  // Walks the LineIndex of the buffer. All tokens are views into `buffer`;
+  // strings are only materialized when DailyData/ProjectData are filled.
+  [[nodiscard]] auto ParseBuffer(std::string_view buffer, ILineCheck* check, ParseResult& result, std::ostream& diag) const -> bool;
+  // Splits the index at date lines into `worker_count` chunks, parses them
+  // concurrently into separate logs and appends those in file order.
+  [[nodiscard]] static auto ParseParallel(std::string_view buffer, std::span<const LineRecord> index, unsigned worker_count, ParseResult& result, std::ostream& diag) -> bool;
+  // Parses the complete lines in `buffer`, continuing from `state`. With a
+  // check, the lines are checked first and only parsed while it passes.
+  [[nodiscard]] static auto ParseLines(std::string_view buffer, ParserState& state) -> bool;
+  [[nodiscard]] static auto ParseRecords(std::string_view buffer, std::span<const LineRecord> records, ParserState& state) -> bool;
+  static auto CheckRecords(std::string_view buffer, std::span<const LineRecord> records, ILineCheck& check) -> void;
+  // Ends a checked streaming parse. Parser warnings in `diag` are only kept,
+  // and the parse only succeeds, if the whole input passed the check.
+  [[nodiscard]] static auto FinishCheck(const ParserState& state, std::ostringstream& diag) -> bool;
+  // Hands the open streaming day (if any) to the sink and rewinds its arena.
+  [[nodiscard]] static auto EmitDay(ParserState& state) -> bool;
+  // Streaming only: records the date line `record` as the latest checkpoint.
+  static auto MarkCheckpoint(const LineRecord& record, ParserState& state) -> void;
 
-  [[nodiscard]] static auto Trim(std::string_view value) -> std::string;
-  [[nodiscard]] static auto SplitComment(std::string_view value) -> std::pair<std::string, std::string>;
-  [[nodiscard]] static auto IsNoteLine(std::string_view text) -> bool;
-  [[nodiscard]] static auto ParseContentLine(const std::string& line, double& out_weight) -> std::vector<SetData>;
+  [[nodiscard]] static auto Trim(std::string_view value) -> std::string_view;
+  // Splits at the comment delimiter position recorded by LineIndex.
+  [[nodiscard]] static auto SplitComment(std::string_view value, std::uint32_t comment_pos) -> std::pair<std::string_view, std::string_view>;
+  // Single pass over "+60kg 10+8+8": adds one set per rep token to `project`
+  // without any intermediate strings or streams. Equal consecutive sets
+  // collapse into a single run, and the note goes into `day`'s note table.
+  static auto ParseContentLine(std::string_view line, std::string_view note, DailyData& day, ProjectData& project, std::ostream& diag) -> void;
 
-  [[nodiscard]] auto HandleYearLine(const std::string& line) -> bool;
-  [[nodiscard]] auto HandleDateLine(const std::string& line, ParserState& state) -> bool;
-  [[nodiscard]] static auto HandleNoteLine(const std::string& line, ParserState& state) -> bool;
-  [[nodiscard]] static auto HandleContentLine(const std::string& line, ParserState& state) -> bool;
-  [[nodiscard]] static auto HandleProjectLine(const std::string& line, ParserState& state) -> bool;
+  [[nodiscard]] static auto HandleYearLine(std::string_view line, ParserState& state) -> bool;
+  [[nodiscard]] static auto HandleDateLine(std::string_view line, ParserState& state) -> bool;
+  [[nodiscard]] static auto HandleNoteLine(std::string_view line, ParserState& state) -> bool;
+  [[nodiscard]] static auto HandleContentLine(std::string_view line, std::uint32_t comment_pos, ParserState& state) -> bool;
+  [[nodiscard]] static auto HandleProjectLine(std::string_view line, std::uint32_t comment_pos, ParserState& state) -> bool;
 };
 
 #endif // CONVERTER_LOG_PARSER_HPP_
\ No newline at end of file
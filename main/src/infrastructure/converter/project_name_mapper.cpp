@@ -4,7 +4,23 @@
 
 #include <cjson/cJSON.h>
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <utility>
+
+#include "infrastructure/config/embedded_mapping.hpp"
+
+namespace {
+
+constexpr std::size_t kMinSlots = 16;
+constexpr std::string_view kUnknownType = "unknown";
+
+auto HashName(std::string_view name) -> std::size_t {
+  return std::hash<std::string_view>{}(name);
+}
+
+}  // namespace
 
 auto ProjectNameMapper::LoadMappings(const cJSON* json_root) -> bool {
   if (json_root == nullptr || cJSON_IsObject(json_root) == 0) {
@@ -12,11 +28,10 @@ auto ProjectNameMapper::LoadMappings(const cJSON* json_root) -> bool {
     return false;
   }
 
+  embedded_ = false;
   cJSON* child = json_root->child;
   while (child != nullptr) {
     if (child->string != nullptr) {
-      std::string key = child->string;
-
       cJSON* full_name_item =
           cJSON_GetObjectItemCaseSensitive(child, "fullName");
       cJSON* type_item = cJSON_GetObjectItemCaseSensitive(child, "type");
@@ -25,8 +40,8 @@ auto ProjectNameMapper::LoadMappings(const cJSON* json_root) -> bool {
           (full_name_item->valuestring != nullptr) &&
           cJSON_IsString(type_item) != 0 &&
           (type_item->valuestring != nullptr)) {
-        mappings_[key] = {.full_name = full_name_item->valuestring,
-                          .type = type_item->valuestring};
+        Insert(child->string, {.full_name = full_name_item->valuestring,
+                               .type = type_item->valuestring});
       }
     }
     child = child->next;
@@ -34,11 +49,89 @@ auto ProjectNameMapper::LoadMappings(const cJSON* json_root) -> bool {
   return true;
 }
 
-auto ProjectNameMapper::GetMapping(const std::string& short_name) const
-    -> ProjectMapping {
-  auto map_it = mappings_.find(short_name);
-  if (map_it != mappings_.end()) {
-    return map_it->second;
+auto ProjectNameMapper::UseEmbeddedMappings() -> void {
+  embedded_ = true;
+  entries_.clear();
+  slots_.clear();
+}
+
+auto ProjectNameMapper::GetMapping(std::string_view short_name) const
+    -> ProjectMappingView {
+  if (embedded_) {
+    if (const auto* mapping = embedded_mapping::Find(short_name);
+        mapping != nullptr) {
+      return {.full_name = mapping->full_name_, .type = mapping->type_};
+    }
+  } else if (!slots_.empty()) {
+    const Slot& slot = slots_[Probe(short_name, HashName(short_name))];
+    if (slot.entry_ != kNoEntry) {
+      const ProjectMapping& mapping = entries_[slot.entry_].mapping_;
+      return {.full_name = mapping.full_name, .type = mapping.type};
+    }
+  }
+  return {.full_name = short_name, .type = kUnknownType};
+}
+
+auto ProjectNameMapper::ForEach(
+    const std::function<void(std::string_view short_name,
+                             const ProjectMappingView& mapping)>& visit) const
+    -> void {
+  if (embedded_) {
+    for (const embedded_mapping::EmbeddedMapping& mapping :
+         embedded_mapping::Mappings()) {
+      visit(mapping.short_name_,
+            {.full_name = mapping.full_name_, .type = mapping.type_});
+    }
+    return;
   }
-  return {.full_name = short_name, .type = "unknown"};
-}
\ No newline at end of file
+  for (const Entry& entry : entries_) {
+    visit(entry.short_name_, {.full_name = entry.mapping_.full_name,
+                              .type = entry.mapping_.type});
+  }
+}
+
+auto ProjectNameMapper::Insert(std::string_view short_name,
+                               ProjectMapping mapping) -> void {
+  if ((entries_.size() + 1) * 2 > slots_.size()) {
+    Rehash(std::max(kMinSlots, slots_.size() * 2));
+  }
+  const std::size_t kHash = HashName(short_name);
+  Slot& slot = slots_[Probe(short_name, kHash)];
+  if (slot.entry_ != kNoEntry) {
+    entries_[slot.entry_].mapping_ = std::move(mapping);
+    return;
+  }
+  slot = {.hash_ = kHash,
+          .entry_ = static_cast<std::uint32_t>(entries_.size())};
+  entries_.push_back(
+      {.short_name_ = std::string(short_name), .mapping_ = std::move(mapping)});
+}
+
+auto ProjectNameMapper::Rehash(std::size_t slot_count) -> void {
+  const std::vector<Slot> kOldSlots =
+      std::exchange(slots_, std::vector<Slot>(slot_count));
+  const std::size_t kMask = slot_count - 1;
+  for (const Slot& old_slot : kOldSlots) {
+    if (old_slot.entry_ == kNoEntry) {
+      continue;
+    }
+    std::size_t index = old_slot.hash_ & kMask;
+    while (slots_[index].entry_ != kNoEntry) {
+      index = (index + 1) & kMask;
+    }
+    slots_[index] = old_slot;
+  }
+}
+
+auto ProjectNameMapper::Probe(std::string_view short_name,
+                              std::size_t hash) const -> std::size_t {
+  // At most half the slots are used, so an empty one always ends the probe.
+  const std::size_t kMask = slots_.size() - 1;
+  std::size_t index = hash & kMask;
+  while (slots_[index].entry_ != kNoEntry &&
+         (slots_[index].hash_ != hash ||
+          entries_[slots_[index].entry_].short_name_ != short_name)) {
+    index = (index + 1) & kMask;
+  }
+  return index;
+}
@@ -3,8 +3,12 @@
 #ifndef CONVERTER_PROJECT_NAME_MAPPER_HPP_
 #define CONVERTER_PROJECT_NAME_MAPPER_HPP_
 
-#include <map>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <cjson/cJSON.h>
 
@@ -14,15 +18,67 @@ struct ProjectMapping {
   std::string type;
 };
 
+// GetMapping() 的结果：指向映射表内的字符串，不做拷贝。
+// 未知项目时 full_name 指向调用方传入的 short_name。
+struct ProjectMappingView {
+  std::string_view full_name;
+  std::string_view type;
+};
+
+/**
+ * @brief Short name -> full name and type, as read from the mapping file.
+ *
+ * An open-addressing table with linear probing over a flat slot array. Each
+ * slot keeps the key's hash next to an index into entries_, so a probe
+ * touches one cache line and compares strings only when the hashes agree.
+ * The built-in mapping instead uses its compile-time perfect hash. Lookups
+ * take a std::string_view and never allocate. Once loaded the mapper is not
+ * modified, so lookups may run on several threads.
+ */
 class ProjectNameMapper {
 public:
   // [MODIFIED] 函数签名更新为接收 cJSON 指针
   [[nodiscard]] auto LoadMappings(const cJSON* json_root) -> bool;
 
-  [[nodiscard]] auto GetMapping(const std::string& short_name) const -> ProjectMapping;
+  // Serves lookups from the mapping compiled into the program (see
+  // infrastructure/config/embedded_mapping.hpp) instead of a loaded file.
+  auto UseEmbeddedMappings() -> void;
+
+  // Unknown names map to themselves with type "unknown"; full_name then views
+  // `short_name`, so that must outlive the result.
+  [[nodiscard]] auto GetMapping(std::string_view short_name) const
+      -> ProjectMappingView;
+
+  // Calls `visit` once for every short name that has a mapping.
+  auto ForEach(const std::function<void(std::string_view short_name,
+                                        const ProjectMappingView& mapping)>&
+                   visit) const -> void;
 
 private:
-  std::map<std::string, ProjectMapping> mappings_;
+  static constexpr std::uint32_t kNoEntry = UINT32_MAX;
+
+  struct Slot {
+    std::size_t hash_ = 0;
+    std::uint32_t entry_ = kNoEntry;
+  };
+
+  struct Entry {
+    std::string short_name_;
+    ProjectMapping mapping_;
+  };
+
+  // Adds or, as a JSON object read in order would, replaces the mapping.
+  auto Insert(std::string_view short_name, ProjectMapping mapping) -> void;
+  auto Rehash(std::size_t slot_count) -> void;
+  // The slot holding `short_name`, or the empty slot where it would go.
+  [[nodiscard]] auto Probe(std::string_view short_name, std::size_t hash) const
+      -> std::size_t;
+
+  // Lookups go to embedded_mapping::Find(); entries_ stays empty.
+  bool embedded_ = false;
+  std::vector<Entry> entries_;
+  // Size is zero or a power of two, at least twice the number of entries.
+  std::vector<Slot> slots_;
 };
 
 #endif // CONVERTER_PROJECT_NAME_MAPPER_HPP_
\ No newline at end of file
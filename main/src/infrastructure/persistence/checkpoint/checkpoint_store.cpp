@@ -0,0 +1,126 @@
+// db/checkpoint/checkpoint_store.cpp
+
+#include "infrastructure/persistence/checkpoint/checkpoint_store.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "domain/services/date_service.hpp"
+
+namespace {
+
+constexpr int kColOffset = 0;
+constexpr int kColHashedBytes = 1;
+constexpr int kColPrefixHash = 2;
+constexpr int kColYear = 3;
+constexpr int kColLineCount = 4;
+constexpr int kColCheckedLineCount = 5;
+constexpr int kColSealedDays = 6;
+constexpr int kColCycleId = 7;
+constexpr int kColFirstLogId = 8;
+constexpr int kColLastDayLogId = 9;
+
+}  // namespace
+
+CheckpointStore::CheckpointStore(sqlite3* db_handle) : db_(db_handle) {}
+
+auto CheckpointStore::SourceId(const std::string& source) -> sqlite3_int64 {
+  const char* sql_insert =
+      "INSERT OR IGNORE INTO ingest_sources (source) VALUES (?);";
+  const char* sql_select = "SELECT id FROM ingest_sources WHERE source = ?;";
+
+  sqlite3_int64 source_id = 0;
+  for (const char* sql : {sql_insert, sql_select}) {
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+      throw std::runtime_error("Failed to prepare statement: " +
+                               std::string(sqlite3_errmsg(db_)));
+    }
+    sqlite3_bind_text(stmt, 1, source.c_str(), -1, SQLITE_STATIC);
+    const int kResult = sqlite3_step(stmt);
+    if (kResult == SQLITE_ROW) {
+      source_id = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    if (kResult != SQLITE_ROW && kResult != SQLITE_DONE) {
+      throw std::runtime_error("Error registering ingest source: " +
+                               std::string(sqlite3_errmsg(db_)));
+    }
+  }
+  if (source_id == 0) {
+    throw std::runtime_error("Error registering ingest source: " + source);
+  }
+  return source_id;
+}
+
+auto CheckpointStore::Load(const std::string& source) const
+    -> std::optional<IngestCheckpoint> {
+  const char* sql =
+      "SELECT resume_offset, hashed_bytes, prefix_hash, year, line_count, "
+      "checked_line_count, sealed_days, cycle_id, first_log_id, "
+      "last_day_log_id FROM ingest_checkpoints WHERE source = ?;";
+
+  sqlite3_stmt* stmt = nullptr;
+  if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+    return std::nullopt;
+  }
+  sqlite3_bind_text(stmt, 1, source.c_str(), -1, SQLITE_STATIC);
+
+  std::optional<IngestCheckpoint> checkpoint;
+  if (sqlite3_step(stmt) == SQLITE_ROW) {
+    IngestCheckpoint& saved = checkpoint.emplace();
+    // SQLite integers are signed; the hash round-trips through int64.
+    saved.parse_.offset_ =
+        static_cast<std::uint64_t>(sqlite3_column_int64(stmt, kColOffset));
+    saved.parse_.hashed_bytes_ = static_cast<std::uint64_t>(
+        sqlite3_column_int64(stmt, kColHashedBytes));
+    saved.parse_.prefix_hash_ = static_cast<std::uint64_t>(
+        sqlite3_column_int64(stmt, kColPrefixHash));
+    saved.parse_.year_ = sqlite3_column_int(stmt, kColYear);
+    saved.parse_.line_count_ = sqlite3_column_int(stmt, kColLineCount);
+    saved.parse_.checked_line_count_ =
+        sqlite3_column_int(stmt, kColCheckedLineCount);
+    saved.parse_.sealed_days_ = sqlite3_column_int(stmt, kColSealedDays);
+    saved.cycle_id_ =
+        DateService::FromDayNumber(sqlite3_column_int64(stmt, kColCycleId));
+    saved.first_log_id_ = sqlite3_column_int64(stmt, kColFirstLogId);
+    saved.last_day_log_id_ = sqlite3_column_int64(stmt, kColLastDayLogId);
+  }
+  sqlite3_finalize(stmt);
+  return checkpoint;
+}
+
+auto CheckpointStore::Save(const std::string& source,
+                           const IngestCheckpoint& checkpoint) -> void {
+  const char* sql =
+      "INSERT OR REPLACE INTO ingest_checkpoints (source, resume_offset, "
+      "hashed_bytes, prefix_hash, year, line_count, checked_line_count, "
+      "sealed_days, cycle_id, first_log_id, last_day_log_id) "
+      "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+
+  sqlite3_stmt* stmt = nullptr;
+  if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+    throw std::runtime_error("Failed to prepare statement: " +
+                             std::string(sqlite3_errmsg(db_)));
+  }
+  const ParseCheckpoint& parse = checkpoint.parse_;
+  sqlite3_bind_text(stmt, 1, source.c_str(), -1, SQLITE_STATIC);
+  sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(parse.offset_));
+  sqlite3_bind_int64(stmt, 3, static_cast<sqlite3_int64>(parse.hashed_bytes_));
+  sqlite3_bind_int64(stmt, 4, static_cast<sqlite3_int64>(parse.prefix_hash_));
+  sqlite3_bind_int(stmt, 5, parse.year_);
+  sqlite3_bind_int(stmt, 6, parse.line_count_);
+  sqlite3_bind_int(stmt, 7, parse.checked_line_count_);
+  sqlite3_bind_int(stmt, 8, parse.sealed_days_);
+  sqlite3_bind_int64(stmt, 9, DateService::ToDayNumber(checkpoint.cycle_id_));
+  sqlite3_bind_int64(stmt, 10, checkpoint.first_log_id_);
+  sqlite3_bind_int64(stmt, 11, checkpoint.last_day_log_id_);
+
+  const int kResult = sqlite3_step(stmt);
+  sqlite3_finalize(stmt);
+  if (kResult != SQLITE_DONE) {
+    throw std::runtime_error("Error saving ingest checkpoint: " +
+                             std::string(sqlite3_errmsg(db_)));
+  }
+}
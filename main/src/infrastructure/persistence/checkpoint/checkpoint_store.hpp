@@ -0,0 +1,49 @@
+// db/checkpoint/checkpoint_store.hpp
+
+#ifndef DB_CHECKPOINT_CHECKPOINT_STORE_HPP_
+#define DB_CHECKPOINT_CHECKPOINT_STORE_HPP_
+
+#include "domain/models/parse_checkpoint.hpp"
+#include "sqlite3.h"
+#include <chrono>
+#include <optional>
+#include <string>
+
+/**
+ * @brief 一个源文件上次 ingest 停在哪里, 以及当时写入的行。
+ *
+ * 与训练数据写在同一个事务中, 因此检查点永远与数据库内容一致。
+ */
+struct IngestCheckpoint {
+  ParseCheckpoint parse_;
+  std::chrono::sys_days cycle_id_{};
+  sqlite3_int64 first_log_id_ = 0;     // 周期的第一行日志
+  sqlite3_int64 last_day_log_id_ = 0;  // 最后一天 (可能仍会增长) 的第一行日志
+};
+
+class CheckpointStore {
+public:
+  explicit CheckpointStore(sqlite3* db_handle);
+
+  /**
+   * @brief source 在 ingest_sources 中的编号, 第一次 ingest 时分配。
+   *        training_logs.source_id 以此标明每一行来自哪个源文件。
+   * @throws std::runtime_error 读写失败时。
+   */
+  auto SourceId(const std::string& source) -> sqlite3_int64;
+
+  [[nodiscard]] auto Load(const std::string& source) const
+      -> std::optional<IngestCheckpoint>;
+
+  /**
+   * @brief 写入或替换 source 的检查点。
+   * @throws std::runtime_error 写入失败时。
+   */
+  auto Save(const std::string& source, const IngestCheckpoint& checkpoint)
+      -> void;
+
+private:
+  sqlite3* db_;
+};
+
+#endif // DB_CHECKPOINT_CHECKPOINT_STORE_HPP_
@@ -3,20 +3,54 @@
 #include "infrastructure/persistence/facade/db_facade.hpp"
 
 #include <iostream>
+#include <optional>
 #include <stdexcept>
 
+#include "infrastructure/persistence/checkpoint/checkpoint_store.hpp"
 #include "infrastructure/persistence/inserter/data_inserter.hpp"
+#include "infrastructure/persistence/mapping/exercise_mapping_store.hpp"
 
-auto DbFacade::InsertTrainingData(sqlite3* db_connection,
-                                  const std::vector<DailyData>& data) -> bool {
-  char* z_err_msg = nullptr;
+namespace {
 
+auto BeginTransaction(sqlite3* db_connection) -> bool {
+  char* z_err_msg = nullptr;
   if (sqlite3_exec(db_connection, "BEGIN TRANSACTION;", nullptr, nullptr,
                    &z_err_msg) != SQLITE_OK) {
     std::cerr << "SQL error starting transaction: " << z_err_msg << std::endl;
     sqlite3_free(z_err_msg);
     return false;
   }
+  return true;
+}
+
+auto CommitTransaction(sqlite3* db_connection) -> bool {
+  char* z_err_msg = nullptr;
+  if (sqlite3_exec(db_connection, "COMMIT;", nullptr, nullptr, &z_err_msg) !=
+      SQLITE_OK) {
+    std::cerr << "SQL error committing transaction: " << z_err_msg << std::endl;
+    sqlite3_free(z_err_msg);
+    sqlite3_exec(db_connection, "ROLLBACK;", nullptr, nullptr, nullptr);
+    return false;
+  }
+  return true;
+}
+
+// Keeps exercise_mappings in step with the rows the inserter just wrote.
+auto RecordMappings(sqlite3* db_connection, const DataInserter& inserter)
+    -> void {
+  if (inserter.FirstLogId() != 0) {
+    ExerciseMappingStore(db_connection)
+        .RecordCycle(inserter.SourceId(), inserter.FirstLogId());
+  }
+}
+
+}  // namespace
+
+auto DbFacade::InsertTrainingData(sqlite3* db_connection,
+                                  const WorkoutLog& data) -> bool {
+  if (!BeginTransaction(db_connection)) {
+    return false;
+  }
 
   try {
     DataInserter inserter(db_connection);
@@ -24,6 +58,7 @@ auto DbFacade::InsertTrainingData(sqlite3* db_connection,
       sqlite3_exec(db_connection, "ROLLBACK;", nullptr, nullptr, nullptr);
       return false;
     }
+    RecordMappings(db_connection, inserter);
   } catch (const std::exception& e) {
     std::cerr << "An error occurred during insertion: " << e.what()
               << std::endl;
@@ -31,13 +66,110 @@ auto DbFacade::InsertTrainingData(sqlite3* db_connection,
     return false;
   }
 
-  if (sqlite3_exec(db_connection, "COMMIT;", nullptr, nullptr, &z_err_msg) !=
-      SQLITE_OK) {
-    std::cerr << "SQL error committing transaction: " << z_err_msg << std::endl;
-    sqlite3_free(z_err_msg);
+  return CommitTransaction(db_connection);
+}
+
+auto DbFacade::InsertTrainingDataIncremental(
+    sqlite3* db_connection, const std::string& source,
+    const std::function<bool(StreamResume&, const DaySink&)>& produce_days)
+    -> bool {
+  if (!BeginTransaction(db_connection)) {
+    return false;
+  }
+
+  try {
+    DataInserter inserter(db_connection);
+    CheckpointStore checkpoints(db_connection);
+    const std::optional<IngestCheckpoint> kSaved =
+        source.empty() ? std::nullopt : checkpoints.Load(source);
+    // Every row stored for the source carries this id, so its rows are
+    // found exactly even when other sources were ingested in between.
+    const sqlite3_int64 kSourceId = source.empty()
+                                        ? DataInserter::kNoSource
+                                        : checkpoints.SourceId(source);
+
+    // Drops what earlier runs stored for this source and starts a new cycle.
+    auto start_over = [&]() -> void {
+      if (kSaved.has_value() && kSaved->first_log_id_ != 0) {
+        inserter.DeleteLogsFrom(kSourceId, kSaved->first_log_id_);
+      }
+      inserter.BeginCycle(kSourceId);
+    };
+
+    StreamResume resume;
+    if (kSaved.has_value() && kSaved->parse_.sealed_days_ > 0) {
+      std::cout << "Resuming from line " << kSaved->parse_.line_count_ + 1
+                << "; days already stored: " << kSaved->parse_.sealed_days_
+                << "." << std::endl;
+      // The last stored day may have grown since; it is read again.
+      inserter.ResumeCycle(kSourceId, kSaved->cycle_id_,
+                           kSaved->first_log_id_, kSaved->parse_.sealed_days_);
+      if (kSaved->last_day_log_id_ != 0) {
+        inserter.DeleteLogsFrom(kSourceId, kSaved->last_day_log_id_);
+      }
+      resume.from_ = kSaved->parse_;
+    } else {
+      start_over();
+    }
+
+    const DaySink kSink = [&](DailyData& daily, SymbolTable& symbols) -> bool {
+      inserter.InsertDay(daily, symbols);
+      return true;
+    };
+    bool produced = produce_days(resume, kSink);
+    if (resume.stale_) {
+      std::cout << "The beginning of the file has changed since the last "
+                   "ingest; replacing its data."
+                << std::endl;
+      start_over();
+      resume = {};
+      produced = produce_days(resume, kSink);
+    }
+
+    if (!produced || !inserter.FinishCycle() || !resume.next_.has_value()) {
+      sqlite3_exec(db_connection, "ROLLBACK;", nullptr, nullptr, nullptr);
+      return false;
+    }
+    RecordMappings(db_connection, inserter);
+    if (!source.empty()) {
+      checkpoints.Save(source, {.parse_ = resume.next_.value(),
+                                .cycle_id_ = inserter.CycleId(),
+                                .first_log_id_ = inserter.FirstLogId(),
+                                .last_day_log_id_ = inserter.LastDayLogId()});
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "An error occurred during insertion: " << e.what()
+              << std::endl;
     sqlite3_exec(db_connection, "ROLLBACK;", nullptr, nullptr, nullptr);
     return false;
   }
 
-  return true;
-}
\ No newline at end of file
+  return CommitTransaction(db_connection);
+}
+
+auto DbFacade::RemapExercises(sqlite3* db_connection,
+                              const ProjectNameMapper& mapper)
+    -> std::optional<RemapSummary> {
+  if (!BeginTransaction(db_connection)) {
+    return std::nullopt;
+  }
+
+  RemapSummary summary;
+  try {
+    ExerciseMappingStore store(db_connection);
+    summary.mapping_count_ = store.Replace(mapper);
+    summary.backfilled_logs_ = store.BackfillCodes();
+    summary.updated_logs_ = store.ApplyToLogs();
+    summary.uncoded_logs_ = store.CountUncodedLogs();
+  } catch (const std::exception& e) {
+    std::cerr << "An error occurred during remapping: " << e.what()
+              << std::endl;
+    sqlite3_exec(db_connection, "ROLLBACK;", nullptr, nullptr, nullptr);
+    return std::nullopt;
+  }
+
+  if (!CommitTransaction(db_connection)) {
+    return std::nullopt;
+  }
+  return summary;
+}
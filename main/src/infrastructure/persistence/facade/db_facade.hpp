@@ -3,10 +3,23 @@
 #ifndef DB_FACADE_DB_FACADE_HPP_
 #define DB_FACADE_DB_FACADE_HPP_
 
-#include "domain/models/workout_item.hpp"
+#include "domain/models/parse_checkpoint.hpp"
+#include "domain/models/workout_log.hpp"
+#include "infrastructure/converter/project_name_mapper.hpp"
 #include "sqlite3.h"
+#include <functional>
+#include <optional>
+#include <string>
 #include <vector>
 
+// RemapExercises() 的结果。
+struct RemapSummary {
+  sqlite3_int64 mapping_count_ = 0;   // 写入 exercise_mappings 的映射数
+  sqlite3_int64 backfilled_logs_ = 0; // 补上简称的旧日志行
+  sqlite3_int64 updated_logs_ = 0;    // 名称或类型改变的日志行
+  sqlite3_int64 uncoded_logs_ = 0;    // 没有简称、未能重新映射的日志行
+};
+
 /**
  * @brief 数据库操作的外观类。
  */
@@ -15,11 +28,39 @@ public:
   /**
    * @brief 将训练数据插入数据库。
    * @param db 数据库连接指针。
-   * @param data 训练数据向量。
+   * @param data 解析后的训练日志。
    * @return 成功返回 true，失败返回 false。
    */
   static auto InsertTrainingData(sqlite3* db,
-                                 const std::vector<DailyData>& data) -> bool;
+                                 const WorkoutLog& data) -> bool;
+
+  /**
+   * @brief 在同一个事务中逐日插入一个只追加的源文件, 并保存检查点。
+   *
+   * 若 source 已有检查点, 只插入检查点之后的日期: 上次的最后一天会被删除
+   * 并重新读取, 因为它可能在此期间增长。若文件开头已经改变, 则删除该文件
+   * 先前写入的整个周期, 从头插入。
+   * @param db 数据库连接指针。
+   * @param source 源文件的规范路径, 用作检查点的键。为空时 (例如从标准输入
+   *        读取) 不读写检查点, 每次都插入一个新周期。
+   * @param produce_days 数据生产者, 从 resume.from_ (若有) 开始对每个完成
+   *        的日期调用传入的 sink, 并填写 resume.next_ 与 resume.stale_。
+   * @return 生产者与插入均成功时返回 true, 否则回滚并返回 false。
+   */
+  static auto InsertTrainingDataIncremental(
+      sqlite3* db, const std::string& source,
+      const std::function<bool(StreamResume&, const DaySink&)>& produce_days)
+      -> bool;
+
+  /**
+   * @brief 按 mapper 重新映射已存储日志的名称与类型, 无需重新导入。
+   *
+   * 在同一个事务中替换 exercise_mappings, 为能够确定简称的旧日志行补上
+   * 简称, 再把映射应用到 training_logs。
+   * @return 失败时回滚并返回 std::nullopt。
+   */
+  static auto RemapExercises(sqlite3* db, const ProjectNameMapper& mapper)
+      -> std::optional<RemapSummary>;
 };
 
 #endif // DB_FACADE_DB_FACADE_HPP_
\ No newline at end of file
@@ -3,11 +3,14 @@
 
 #include <iostream>
 
+#include "domain/models/weight.hpp"
+#include "domain/services/date_service.hpp"
+
 auto QueryFacade::QueryAllPRs(sqlite3* sqlite_db)
     -> std::vector<PersonalRecord> {
   std::vector<PersonalRecord> prs;
   const char* sql =
-      "SELECT l.exercise_name, MAX(s.weight), s.reps, l.date "
+      "SELECT l.exercise_name, MAX(s.weight_g), s.reps, l.date "
       "FROM training_sets s "
       "JOIN training_logs l ON s.log_id = l.id "
       "GROUP BY l.exercise_name "
@@ -24,9 +27,9 @@ auto QueryFacade::QueryAllPRs(sqlite3* sqlite_db)
     PersonalRecord record;
     record.exercise_name =
         reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-    record.max_weight = sqlite3_column_double(stmt, 1);
+    record.max_weight = Weight::ToKg(sqlite3_column_int64(stmt, 1));
     record.reps = sqlite3_column_int(stmt, 2);
-    record.date = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+    record.date = DateService::FromDayNumber(sqlite3_column_int64(stmt, 3));
 
     // Calculate estimated 1RM
     if (record.reps <= 1) {
@@ -107,8 +110,7 @@ auto QueryFacade::GetAllCycles(sqlite3* sqlite_db) -> std::vector<CycleRecord> {
 
   while (sqlite3_step(stmt) == SQLITE_ROW) {
     CycleRecord record;
-    record.cycle_id =
-        reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    record.cycle_id = DateService::FromDayNumber(sqlite3_column_int64(stmt, 0));
     record.total_days = sqlite3_column_int(stmt, 1);
 
     const unsigned char* types_text = sqlite3_column_text(stmt, 2);
@@ -117,9 +119,8 @@ auto QueryFacade::GetAllCycles(sqlite3* sqlite_db) -> std::vector<CycleRecord> {
                       : "";
 
     record.start_date =
-        reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
-    record.end_date =
-        reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
+        DateService::FromDayNumber(sqlite3_column_int64(stmt, 3));
+    record.end_date = DateService::FromDayNumber(sqlite3_column_int64(stmt, 4));
     cycles.push_back(record);
   }
 
@@ -127,19 +128,17 @@ auto QueryFacade::GetAllCycles(sqlite3* sqlite_db) -> std::vector<CycleRecord> {
   return cycles;
 }
 auto QueryFacade::GetVolumeStats(sqlite3* sqlite_db,
-                                 const std::string& cycle_id,
+                                 std::chrono::sys_days cycle_id,
                                  const std::string& type)
     -> std::optional<VolumeStats> {
   const char* sql =
-      "SELECT l.cycle_id, l.exercise_type, SUM(s.weight * s.reps), "
+      "SELECT l.cycle_id, l.exercise_type, SUM(s.volume_g), "
       "MAX(l.total_days), "
-      "CAST(SUM(s.weight * s.reps) AS DOUBLE) / SUM(s.reps), "
+      "CAST(SUM(s.volume_g) AS DOUBLE) / SUM(s.reps), "
       "COUNT(DISTINCT l.id), SUM(s.reps), COUNT(s.id), "
-      "SUM(CASE WHEN s.reps BETWEEN 1 AND 5 THEN s.weight * s.reps ELSE 0 "
-      "END), "
-      "SUM(CASE WHEN s.reps BETWEEN 6 AND 12 THEN s.weight * s.reps ELSE 0 "
-      "END), "
-      "SUM(CASE WHEN s.reps >= 13 THEN s.weight * s.reps ELSE 0 END) "
+      "SUM(CASE WHEN s.reps BETWEEN 1 AND 5 THEN s.volume_g ELSE 0 END), "
+      "SUM(CASE WHEN s.reps BETWEEN 6 AND 12 THEN s.volume_g ELSE 0 END), "
+      "SUM(CASE WHEN s.reps >= 13 THEN s.volume_g ELSE 0 END) "
       "FROM training_logs l "
       "JOIN training_sets s ON l.id = s.log_id "
       "WHERE l.cycle_id = ? AND l.exercise_type = ? "
@@ -152,7 +151,7 @@ auto QueryFacade::GetVolumeStats(sqlite3* sqlite_db,
     return std::nullopt;
   }
 
-  sqlite3_bind_text(stmt, 1, cycle_id.c_str(), -1, SQLITE_STATIC);
+  sqlite3_bind_int64(stmt, 1, DateService::ToDayNumber(cycle_id));
   sqlite3_bind_text(stmt, 2, type.c_str(), -1, SQLITE_STATIC);
 
   std::optional<VolumeStats> stats;
@@ -171,18 +170,23 @@ auto QueryFacade::GetVolumeStats(sqlite3* sqlite_db,
 
     VolumeStats v_stats;
     v_stats.cycle_id =
-        reinterpret_cast<const char*>(sqlite3_column_text(stmt, kColCycleId));
+        DateService::FromDayNumber(sqlite3_column_int64(stmt, kColCycleId));
     v_stats.exercise_type = reinterpret_cast<const char*>(
         sqlite3_column_text(stmt, kColExerciseType));
-    v_stats.total_volume = sqlite3_column_double(stmt, kColTotalVolume);
+    // Volumes are summed as integer gram-reps and converted to kg only here
+    v_stats.total_volume =
+        Weight::ToKg(sqlite3_column_int64(stmt, kColTotalVolume));
     v_stats.total_days = sqlite3_column_int(stmt, kColTotalDays);
-    v_stats.average_intensity = sqlite3_column_double(stmt, kColAvgIntensity);
+    v_stats.average_intensity =
+        sqlite3_column_double(stmt, kColAvgIntensity) / Weight::kGramsPerKg;
     v_stats.session_count = sqlite3_column_int(stmt, kColSessionCount);
     v_stats.total_reps = sqlite3_column_int(stmt, kColTotalReps);
     v_stats.total_sets = sqlite3_column_int(stmt, kColTotalSets);
-    v_stats.vol_power = sqlite3_column_double(stmt, kColVolPower);
-    v_stats.vol_hypertrophy = sqlite3_column_double(stmt, kColVolHypertrophy);
-    v_stats.vol_endurance = sqlite3_column_double(stmt, kColVolEndurance);
+    v_stats.vol_power = Weight::ToKg(sqlite3_column_int64(stmt, kColVolPower));
+    v_stats.vol_hypertrophy =
+        Weight::ToKg(sqlite3_column_int64(stmt, kColVolHypertrophy));
+    v_stats.vol_endurance =
+        Weight::ToKg(sqlite3_column_int64(stmt, kColVolEndurance));
     stats = v_stats;
   }
 
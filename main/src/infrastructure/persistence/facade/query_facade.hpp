@@ -3,6 +3,7 @@
 #define INFRASTRUCTURE_PERSISTENCE_FACADE_QUERY_FACADE_HPP_
 
 #include "sqlite3.h"
+#include <chrono>
 #include <optional>
 #include <string>
 #include <vector>
@@ -11,7 +12,7 @@ struct PersonalRecord {
   std::string exercise_name;
   double max_weight;
   int reps;
-  std::string date;
+  std::chrono::sys_days date;
   double estimated_1rm_epley;
   double estimated_1rm_brzycki;
 };
@@ -22,15 +23,15 @@ struct ExerciseInfo {
 };
 
 struct CycleRecord {
-  std::string cycle_id;
+  std::chrono::sys_days cycle_id;  // first date of the cycle
   int total_days;
   std::string type;
-  std::string start_date;
-  std::string end_date;
+  std::chrono::sys_days start_date;
+  std::chrono::sys_days end_date;
 };
 
 struct VolumeStats {
-  std::string cycle_id;
+  std::chrono::sys_days cycle_id;
   std::string exercise_type;
   double total_volume;
   int total_days;
@@ -49,7 +50,7 @@ public:
   static auto GetExercisesByType(sqlite3* db, const std::string& type_filter) 
       -> std::vector<ExerciseInfo>;
   static auto GetAllCycles(sqlite3* db) -> std::vector<CycleRecord>;
-  static auto GetVolumeStats(sqlite3* db, const std::string& cycle_id, const std::string& type)
+  static auto GetVolumeStats(sqlite3* db, std::chrono::sys_days cycle_id, const std::string& type)
       -> std::optional<VolumeStats>;
 };
 
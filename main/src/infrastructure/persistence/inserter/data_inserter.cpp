@@ -2,114 +2,246 @@
 
 #include "infrastructure/persistence/inserter/data_inserter.hpp"
 
-#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
+#include <string_view>
+
+#include "domain/services/date_service.hpp"
 
 DataInserter::DataInserter(sqlite3* db_handle) : db_(db_handle) {}
 
+DataInserter::~DataInserter() {
+  FinalizeStatements();
+}
+
 auto DataInserter::InsertSets(sqlite3_stmt* stmt_set, sqlite3_int64 log_id,
-                              const std::vector<SetData>& sets) -> void {
-  for (const auto& set_item : sets) {
-    double weight = set_item.weight_;
-    double elastic_band_weight = 0.0;
-    std::string unit = "kg";
-
-    if (weight < 0) {
-      elastic_band_weight = std::abs(weight);
-      weight = 0.0;
+                              const ProjectData& project,
+                              const DailyData& day) -> void {
+  int set_number = 0;
+  for (const auto& run : project.sets_) {
+    // Elastic bands are stored as weight 0 plus their assistance in grams;
+    // `unit` records the unit the band is displayed in.
+    Weight::Grams weight_g = run.weight_g_;
+    Weight::Grams elastic_band_g = 0;
+    std::string_view unit = "kg";
+
+    if (weight_g < 0) {
+      elastic_band_g = -weight_g;
+      weight_g = 0;
       unit = "lbs";
     }
+    const std::string_view kNote = day.SetNote(run.note_index_);
 
+    // sqlite3_reset keeps the bindings, so a run is bound once and only the
+    // set number changes from row to row.
     sqlite3_bind_int64(stmt_set, kColSetLogId, log_id);
-    sqlite3_bind_int(stmt_set, kColSetNumber, set_item.set_number_);
-    sqlite3_bind_double(stmt_set, kColSetWeight, weight);
-    sqlite3_bind_int(stmt_set, kColSetReps, set_item.reps_);
-    sqlite3_bind_double(stmt_set, kColSetVolume, set_item.volume_);
-    sqlite3_bind_text(stmt_set, kColSetUnit, unit.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_double(stmt_set, kColSetElasticWeight, elastic_band_weight);
-    sqlite3_bind_text(stmt_set, kColSetNote, set_item.note_.c_str(), -1,
-                      SQLITE_STATIC);
-
-    if (sqlite3_step(stmt_set) != SQLITE_DONE) {
-      throw std::runtime_error("Error inserting training set: " +
-                               std::string(sqlite3_errmsg(db_)));
+    sqlite3_bind_int(stmt_set, kColSetWeight, weight_g);
+    sqlite3_bind_int(stmt_set, kColSetReps, run.reps_);
+    sqlite3_bind_int64(stmt_set, kColSetVolume, run.Volume());
+    sqlite3_bind_text(stmt_set, kColSetUnit, unit.data(),
+                      static_cast<int>(unit.size()), SQLITE_STATIC);
+    sqlite3_bind_int(stmt_set, kColSetElasticWeight, elastic_band_g);
+    sqlite3_bind_text(stmt_set, kColSetNote, kNote.data(),
+                      static_cast<int>(kNote.size()), SQLITE_STATIC);
+
+    for (std::uint16_t i = 0; i < run.count_; ++i) {
+      sqlite3_bind_int(stmt_set, kColSetNumber, ++set_number);
+      if (sqlite3_step(stmt_set) != SQLITE_DONE) {
+        throw std::runtime_error("Error inserting training set: " +
+                                 std::string(sqlite3_errmsg(db_)));
+      }
+      sqlite3_reset(stmt_set);
     }
-    sqlite3_reset(stmt_set);
   }
 }
 
-auto DataInserter::Insert(const std::vector<DailyData>& data) -> bool {
+auto DataInserter::Insert(const WorkoutLog& log) -> bool {
+  const std::vector<DailyData>& data = log.Days();
   if (data.empty()) {
     return false;
   }
 
+  BeginCycle();
+  for (const auto& daily : data) {
+    InsertDay(daily, log.Symbols());
+  }
+  return FinishCycle();
+}
+
+auto DataInserter::BeginCycle(sqlite3_int64 source_id) -> void {
+  PrepareStatements();
+  source_id_ = source_id;
+  cycle_id_ = {};
+  first_log_id_ = 0;
+  last_day_log_id_ = 0;
+  day_count_ = 0;
+}
+
+auto DataInserter::ResumeCycle(sqlite3_int64 source_id,
+                               std::chrono::sys_days cycle_id,
+                               sqlite3_int64 first_log_id, int day_count)
+    -> void {
+  PrepareStatements();
+  source_id_ = source_id;
+  cycle_id_ = cycle_id;
+  first_log_id_ = first_log_id;
+  last_day_log_id_ = 0;
+  day_count_ = day_count;
+}
+
+auto DataInserter::DeleteLogsFrom(sqlite3_int64 source_id,
+                                  sqlite3_int64 first_log_id) -> void {
+  // Rows of other sources may sit between and after this source's rows; the
+  // first date of a log says nothing about where it came from.
+  const char* sql_delete_sets =
+      "DELETE FROM training_sets WHERE log_id IN "
+      "(SELECT id FROM training_logs WHERE source_id = ? AND id >= ?);";
+  const char* sql_delete_logs =
+      "DELETE FROM training_logs WHERE source_id = ? AND id >= ?;";
+
+  for (const char* sql : {sql_delete_sets, sql_delete_logs}) {
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+      throw std::runtime_error("Failed to prepare statement: " +
+                               std::string(sqlite3_errmsg(db_)));
+    }
+    sqlite3_bind_int64(stmt, 1, source_id);
+    sqlite3_bind_int64(stmt, 2, first_log_id);
+    const int kResult = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    if (kResult != SQLITE_DONE) {
+      throw std::runtime_error("Error deleting training logs: " +
+                               std::string(sqlite3_errmsg(db_)));
+    }
+  }
+}
+
+auto DataInserter::PrepareStatements() -> void {
+  FinalizeStatements();
+
   const char* sql_insert_log =
       "INSERT INTO training_logs (cycle_id, total_days, date, daily_note, "
-      "project_note, exercise_name, exercise_type, total_volume) "
-      "VALUES (?, ?, ?, ?, ?, ?, ?, ?);";
+      "project_note, exercise_name, exercise_type, total_volume_g, "
+      "exercise_code, source_id) "
+      "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
   const char* sql_insert_set =
-      "INSERT INTO training_sets (log_id, set_number, weight, reps, volume, "
-      "unit, elastic_band_weight, set_note) VALUES (?, ?, ?, ?, ?, ?, ?, ?);";
-
-  sqlite3_stmt* stmt_log = nullptr;
-  sqlite3_stmt* stmt_set = nullptr;
+      "INSERT INTO training_sets (log_id, set_number, weight_g, reps, "
+      "volume_g, unit, elastic_band_g, set_note) "
+      "VALUES (?, ?, ?, ?, ?, ?, ?, ?);";
 
-  if (sqlite3_prepare_v2(db_, sql_insert_log, -1, &stmt_log, nullptr) !=
+  if (sqlite3_prepare_v2(db_, sql_insert_log, -1, &stmt_log_, nullptr) !=
           SQLITE_OK ||
-      sqlite3_prepare_v2(db_, sql_insert_set, -1, &stmt_set, nullptr) !=
+      sqlite3_prepare_v2(db_, sql_insert_set, -1, &stmt_set_, nullptr) !=
           SQLITE_OK) {
     std::string err_msg = "Failed to prepare statement: ";
     err_msg += sqlite3_errmsg(db_);
-    if (stmt_log != nullptr) {
-      sqlite3_finalize(stmt_log);
-    }
-    if (stmt_set != nullptr) {
-      sqlite3_finalize(stmt_set);
-    }
+    FinalizeStatements();
     throw std::runtime_error(err_msg);
   }
+}
 
-  try {
-    std::string cycle_id = data[0].date_;
-    int total_days = static_cast<int>(data.size());
-
-    for (const auto& daily : data) {
-      std::string date = daily.date_;
-
-      for (const auto& proj : daily.projects_) {
-        sqlite3_bind_text(stmt_log, kColLogCycleId, cycle_id.c_str(), -1,
-                          SQLITE_STATIC);
-        sqlite3_bind_int(stmt_log, kColLogTotalDays, total_days);
-        sqlite3_bind_text(stmt_log, kColLogDate, date.c_str(), -1,
-                          SQLITE_STATIC);
-        sqlite3_bind_text(stmt_log, kColLogDailyNote, daily.note_.c_str(), -1,
-                          SQLITE_STATIC);
-        sqlite3_bind_text(stmt_log, kColLogProjectNote, proj.note_.c_str(), -1,
-                          SQLITE_STATIC);
-        sqlite3_bind_text(stmt_log, kColLogExerciseName,
-                          proj.project_name_.c_str(), -1, SQLITE_STATIC);
-        sqlite3_bind_text(stmt_log, kColLogExerciseType, proj.type_.c_str(), -1,
-                          SQLITE_STATIC);
-        sqlite3_bind_double(stmt_log, kColLogTotalVolume, proj.total_volume_);
-
-        if (sqlite3_step(stmt_log) != SQLITE_DONE) {
-          throw std::runtime_error("Error inserting training log: " +
-                                   std::string(sqlite3_errmsg(db_)));
-        }
-        sqlite3_reset(stmt_log);
-
-        sqlite3_int64 last_log_id = sqlite3_last_insert_rowid(db_);
-        InsertSets(stmt_set, last_log_id, proj.sets_);
-      }
+auto DataInserter::InsertDay(const DailyData& daily,
+                             const SymbolTable& symbols) -> void {
+  // The first day's date identifies the cycle; total_days is unknown until
+  // the stream ends and is written by FinishCycle().
+  if (day_count_ == 0) {
+    cycle_id_ = daily.date_;
+  }
+  day_count_++;
+  last_day_log_id_ = 0;
+
+  for (const auto& proj : daily.projects_) {
+    const std::string_view kName = symbols.Resolve(proj.project_name_id_);
+    const std::string_view kType = symbols.Resolve(proj.type_id_);
+    sqlite3_bind_int64(stmt_log_, kColLogCycleId,
+                       DateService::ToDayNumber(cycle_id_));
+    sqlite3_bind_int(stmt_log_, kColLogTotalDays, 0);
+    sqlite3_bind_int64(stmt_log_, kColLogDate,
+                       DateService::ToDayNumber(daily.date_));
+    sqlite3_bind_text(stmt_log_, kColLogDailyNote, daily.note_.c_str(), -1,
+                      SQLITE_STATIC);
+    sqlite3_bind_text(stmt_log_, kColLogProjectNote, proj.note_.c_str(), -1,
+                      SQLITE_STATIC);
+    sqlite3_bind_text(stmt_log_, kColLogExerciseName, kName.data(),
+                      static_cast<int>(kName.size()), SQLITE_STATIC);
+    sqlite3_bind_text(stmt_log_, kColLogExerciseType, kType.data(),
+                      static_cast<int>(kType.size()), SQLITE_STATIC);
+    sqlite3_bind_int64(stmt_log_, kColLogTotalVolume, proj.total_volume_g_);
+    // JSON written before codes were recorded has none; the row is then
+    // stored with a NULL code and left alone by a remap.
+    if (proj.short_name_id_ == SymbolTable::kEmpty) {
+      sqlite3_bind_null(stmt_log_, kColLogExerciseCode);
+    } else {
+      const std::string_view kCode = symbols.Resolve(proj.short_name_id_);
+      sqlite3_bind_text(stmt_log_, kColLogExerciseCode, kCode.data(),
+                        static_cast<int>(kCode.size()), SQLITE_STATIC);
+    }
+
+    if (source_id_ == kNoSource) {
+      sqlite3_bind_null(stmt_log_, kColLogSourceId);
+    } else {
+      sqlite3_bind_int64(stmt_log_, kColLogSourceId, source_id_);
+    }
+
+    if (sqlite3_step(stmt_log_) != SQLITE_DONE) {
+      throw std::runtime_error("Error inserting training log: " +
+                               std::string(sqlite3_errmsg(db_)));
+    }
+    sqlite3_reset(stmt_log_);
+
+    sqlite3_int64 last_log_id = sqlite3_last_insert_rowid(db_);
+    if (first_log_id_ == 0) {
+      first_log_id_ = last_log_id;
     }
-  } catch (const std::exception& e) {
-    sqlite3_finalize(stmt_log);
-    sqlite3_finalize(stmt_set);
-    throw;
+    if (last_day_log_id_ == 0) {
+      last_day_log_id_ = last_log_id;
+    }
+    InsertSets(stmt_set_, last_log_id, proj, daily);
   }
+}
 
-  sqlite3_finalize(stmt_log);
-  sqlite3_finalize(stmt_set);
+auto DataInserter::FinishCycle() -> bool {
+  FinalizeStatements();
+  if (day_count_ == 0) {
+    return false;
+  }
+  if (first_log_id_ == 0) {
+    return true;
+  }
+
+  // Without a source every row from first_log_id_ on was written by this
+  // transaction and source_id is left unbound, i.e. NULL. A source's resumed
+  // cycle may have other sources' rows between its own.
+  sqlite3_stmt* stmt_days = nullptr;
+  if (sqlite3_prepare_v2(db_,
+                         "UPDATE training_logs SET total_days = ? "
+                         "WHERE source_id IS ? AND id >= ?;",
+                         -1, &stmt_days, nullptr) != SQLITE_OK) {
+    throw std::runtime_error("Failed to prepare statement: " +
+                             std::string(sqlite3_errmsg(db_)));
+  }
+  sqlite3_bind_int(stmt_days, 1, day_count_);
+  if (source_id_ != kNoSource) {
+    sqlite3_bind_int64(stmt_days, 2, source_id_);
+  }
+  sqlite3_bind_int64(stmt_days, 3, first_log_id_);
+  const int kResult = sqlite3_step(stmt_days);
+  sqlite3_finalize(stmt_days);
+  if (kResult != SQLITE_DONE) {
+    throw std::runtime_error("Error updating total_days: " +
+                             std::string(sqlite3_errmsg(db_)));
+  }
   return true;
 }
+
+auto DataInserter::FinalizeStatements() -> void {
+  if (stmt_log_ != nullptr) {
+    sqlite3_finalize(stmt_log_);
+    stmt_log_ = nullptr;
+  }
+  if (stmt_set_ != nullptr) {
+    sqlite3_finalize(stmt_set_);
+    stmt_set_ = nullptr;
+  }
+}
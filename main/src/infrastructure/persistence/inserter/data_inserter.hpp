@@ -4,19 +4,65 @@
 #define DB_INSERTER_DATA_INSERTER_HPP_
 
 #include "domain/models/workout_item.hpp"
+#include "domain/models/workout_log.hpp"
 #include "sqlite3.h"
+#include <chrono>
+#include <string>
 #include <vector>
 
 class DataInserter {
 public:
   explicit DataInserter(sqlite3* db_handle);
+  ~DataInserter();
+
+  DataInserter(const DataInserter&) = delete;
+  auto operator=(const DataInserter&) -> DataInserter& = delete;
 
   /**
    * @brief 插入训练数据到数据库。
-   * @param data 训练数据向量。
+   * @param log 解析后的训练日志, 动作名称与类型在绑定时才从符号表解析。
    * @return 成功返回 true，否则返回 false。
    */
-  auto Insert(const std::vector<DailyData>& data) -> bool;
+  auto Insert(const WorkoutLog& log) -> bool;
+
+  // 不属于任何 ingest 源文件的行 (source_id 为 NULL)
+  static constexpr sqlite3_int64 kNoSource = 0;
+
+  /**
+   * @brief 流式插入: BeginCycle() 之后逐日调用 InsertDay(),
+   *        最后由 FinishCycle() 回填 total_days。
+   * @param source_id 写入各行的 source_id (见 CheckpointStore::SourceId)。
+   * @return FinishCycle() 在没有插入任何一天时返回 false。
+   */
+  auto BeginCycle(sqlite3_int64 source_id = kNoSource) -> void;
+  auto InsertDay(const DailyData& daily, const SymbolTable& symbols) -> void;
+  auto FinishCycle() -> bool;
+
+  /**
+   * @brief 续写源文件 source_id 的已有周期: 之后插入的日期接在 day_count
+   *        天之后, FinishCycle() 会回填整个周期的 total_days。
+   */
+  auto ResumeCycle(sqlite3_int64 source_id, std::chrono::sys_days cycle_id,
+                   sqlite3_int64 first_log_id, int day_count) -> void;
+
+  /**
+   * @brief 删除源文件 source_id 中 id 不小于 first_log_id 的日志及其组。
+   *        其他源文件的行即使 id 更大、周期相同也不受影响。
+   */
+  auto DeleteLogsFrom(sqlite3_int64 source_id, sqlite3_int64 first_log_id)
+      -> void;
+
+  [[nodiscard]] auto SourceId() const -> sqlite3_int64 { return source_id_; }
+  [[nodiscard]] auto CycleId() const -> std::chrono::sys_days {
+    return cycle_id_;
+  }
+  [[nodiscard]] auto FirstLogId() const -> sqlite3_int64 {
+    return first_log_id_;
+  }
+  // First log row of the most recently inserted day; 0 if it had none
+  [[nodiscard]] auto LastDayLogId() const -> sqlite3_int64 {
+    return last_day_log_id_;
+  }
 
 private:
   static constexpr int kColLogCycleId = 1;
@@ -27,6 +73,8 @@ private:
   static constexpr int kColLogExerciseName = 6;
   static constexpr int kColLogExerciseType = 7;
   static constexpr int kColLogTotalVolume = 8;
+  static constexpr int kColLogExerciseCode = 9;
+  static constexpr int kColLogSourceId = 10;
 
   static constexpr int kColSetLogId = 1;
   static constexpr int kColSetNumber = 2;
@@ -38,9 +86,20 @@ private:
   static constexpr int kColSetNote = 8;
 
   sqlite3* db_;
-  
+  sqlite3_stmt* stmt_log_ = nullptr;
+  sqlite3_stmt* stmt_set_ = nullptr;
+  sqlite3_int64 source_id_ = kNoSource;
+  std::chrono::sys_days cycle_id_{};  // first date of the cycle
+  sqlite3_int64 first_log_id_ = 0;
+  sqlite3_int64 last_day_log_id_ = 0;
+  int day_count_ = 0;
+
+  auto PrepareStatements() -> void;
+  auto FinalizeStatements() -> void;
+
+  // Expands each run into one row per set, numbered by position
   auto InsertSets(sqlite3_stmt* stmt_set, sqlite3_int64 log_id,
-                  const std::vector<SetData>& sets) -> void;
+                  const ProjectData& project, const DailyData& day) -> void;
 };
 
 #endif // DB_INSERTER_DATA_INSERTER_HPP_
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include "infrastructure/persistence/manager/db_manager.hpp"
 
 #include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
 
 DbManager::DbManager(std::string db_path) : db_path_(std::move(db_path)) {}
@@ -32,34 +35,77 @@ auto DbManager::GetConnection() const -> sqlite3* {
   return db_;
 }
 
+namespace {
+
+// Shared by CREATE TABLE and MigrateDatesToDays(), which rebuilds the table.
+// cycle_id and date are days since 1970-01-01; cycle_id is the first date of
+// the cycle. exercise_code is the name as written in the log, which
+// exercise_name and exercise_type were mapped from; NULL for rows stored
+// before it was recorded. source_id is the ingest_sources row of the file an
+// incremental ingest read the row from; NULL for rows stored otherwise.
+constexpr std::string_view kTrainingLogsColumns =
+    "("
+    "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    "  cycle_id INTEGER NOT NULL,"
+    "  total_days INTEGER NOT NULL,"
+    "  date INTEGER NOT NULL,"
+    "  daily_note TEXT DEFAULT '',"
+    "  project_note TEXT DEFAULT '',"
+    "  exercise_name TEXT NOT NULL,"
+    "  exercise_type TEXT NOT NULL,"
+    "  total_volume_g INTEGER NOT NULL,"
+    "  exercise_code TEXT,"
+    "  source_id INTEGER"
+    ")";
+
+}  // namespace
+
 auto DbManager::CreateTables() -> bool {
-  const char* sql =
-      "CREATE TABLE IF NOT EXISTS training_logs ("
-      "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
-      "  cycle_id TEXT NOT NULL,"
-      "  total_days INTEGER NOT NULL,"
-      "  date TEXT NOT NULL,"
-      "  daily_note TEXT DEFAULT '',"
-      "  project_note TEXT DEFAULT '',"
-      "  exercise_name TEXT NOT NULL,"
-      "  exercise_type TEXT NOT NULL,"
-      "  total_volume REAL NOT NULL"
-      ");"
+  const std::string sql =
+      "CREATE TABLE IF NOT EXISTS training_logs " +
+      std::string(kTrainingLogsColumns) +
+      ";"
       "CREATE TABLE IF NOT EXISTS training_sets ("
       "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
       "  log_id INTEGER NOT NULL,"
       "  set_number INTEGER NOT NULL,"
-      "  weight REAL NOT NULL,"
+      "  weight_g INTEGER NOT NULL,"
       "  reps INTEGER NOT NULL,"
-      "  volume REAL NOT NULL,"
+      "  volume_g INTEGER NOT NULL,"
       "  unit TEXT DEFAULT 'kg',"
-      "  elastic_band_weight REAL DEFAULT 0.0,"
+      "  elastic_band_g INTEGER DEFAULT 0,"
       "  set_note TEXT DEFAULT '',"
       "  FOREIGN KEY (log_id) REFERENCES training_logs (id)"
-      ");";
+      ");"
+      // One row per ingested source file; see CheckpointStore
+      "CREATE TABLE IF NOT EXISTS ingest_sources ("
+      "  id INTEGER PRIMARY KEY,"
+      "  source TEXT NOT NULL UNIQUE"
+      ");"
+      "CREATE TABLE IF NOT EXISTS ingest_checkpoints ("
+      "  source TEXT PRIMARY KEY,"
+      "  resume_offset INTEGER NOT NULL,"
+      "  hashed_bytes INTEGER NOT NULL,"
+      "  prefix_hash INTEGER NOT NULL,"
+      "  year INTEGER NOT NULL,"
+      "  line_count INTEGER NOT NULL,"
+      "  checked_line_count INTEGER NOT NULL,"
+      "  sealed_days INTEGER NOT NULL,"
+      "  cycle_id INTEGER NOT NULL,"
+      "  first_log_id INTEGER NOT NULL,"
+      "  last_day_log_id INTEGER NOT NULL"
+      ");"
+      // The mapping the stored names and types come from; see
+      // ExerciseMappingStore
+      "CREATE TABLE IF NOT EXISTS exercise_mappings ("
+      "  code TEXT PRIMARY KEY,"
+      "  exercise_name TEXT NOT NULL,"
+      "  exercise_type TEXT NOT NULL"
+      ") WITHOUT ROWID;";
 
   char* z_err_msg = nullptr;
-  if (sqlite3_exec(db_, sql, nullptr, nullptr, &z_err_msg) != SQLITE_OK) {
+  if (sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, &z_err_msg) !=
+      SQLITE_OK) {
     std::cerr << "SQL error creating tables: " << z_err_msg << std::endl;
     sqlite3_free(z_err_msg);
     return false;
@@ -74,25 +120,7 @@ auto DbManager::CreateTables() -> bool {
   };
 
   auto ensure_column = [&](const ColumnParams& params) -> bool {
-    sqlite3_stmt* stmt = nullptr;
-    bool has_column = false;
-    std::string pragma_sql =
-        "PRAGMA table_info(" + std::string(params.table_name) + ");";
-    if (sqlite3_prepare_v2(db_, pragma_sql.c_str(), -1, &stmt, nullptr) ==
-        SQLITE_OK) {
-      while (sqlite3_step(stmt) == SQLITE_ROW) {
-        const unsigned char* col_text = sqlite3_column_text(stmt, 1);
-        if (col_text != nullptr && std::string(reinterpret_cast<const char*>(
-                                       col_text)) == params.column_name) {
-          has_column = true;
-          break;
-        }
-      }
-    }
-    if (stmt != nullptr) {
-      sqlite3_finalize(stmt);
-    }
-    if (has_column) {
+    if (HasColumn(params.table_name, params.column_name)) {
       return true;
     }
     std::string alter_sql = "ALTER TABLE " + std::string(params.table_name) +
@@ -116,7 +144,188 @@ auto DbManager::CreateTables() -> bool {
          ensure_column({.table_name = "training_logs",
                         .column_name = "project_note",
                         .column_definition = "project_note TEXT DEFAULT ''"}) &&
+         ensure_column({.table_name = "training_logs",
+                        .column_name = "exercise_code",
+                        .column_definition = "exercise_code TEXT"}) &&
          ensure_column({.table_name = "training_sets",
                         .column_name = "set_note",
-                        .column_definition = "set_note TEXT DEFAULT ''"});
+                        .column_definition = "set_note TEXT DEFAULT ''"}) &&
+         MigrateWeightsToGrams() && MigrateLogSources() &&
+         MigrateDatesToDays() && CreateIndexes();
+}
+
+auto DbManager::ColumnType(std::string_view table_name,
+                           std::string_view column_name) const
+    -> std::optional<std::string> {
+  constexpr int kColName = 1;
+  constexpr int kColType = 2;
+  sqlite3_stmt* stmt = nullptr;
+  std::optional<std::string> column_type;
+  std::string pragma_sql =
+      "PRAGMA table_info(" + std::string(table_name) + ");";
+  if (sqlite3_prepare_v2(db_, pragma_sql.c_str(), -1, &stmt, nullptr) ==
+      SQLITE_OK) {
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      const unsigned char* col_text = sqlite3_column_text(stmt, kColName);
+      if (col_text != nullptr &&
+          std::string_view(reinterpret_cast<const char*>(col_text)) ==
+              column_name) {
+        const unsigned char* type_text = sqlite3_column_text(stmt, kColType);
+        column_type = (type_text != nullptr)
+                          ? reinterpret_cast<const char*>(type_text)
+                          : "";
+        break;
+      }
+    }
+  }
+  if (stmt != nullptr) {
+    sqlite3_finalize(stmt);
+  }
+  return column_type;
+}
+
+auto DbManager::HasColumn(std::string_view table_name,
+                          std::string_view column_name) const -> bool {
+  return ColumnType(table_name, column_name).has_value();
+}
+
+auto DbManager::MigrateWeightsToGrams() -> bool {
+  if (!HasColumn("training_sets", "weight")) {
+    return true;
+  }
+
+  // Databases written before weights became integer grams: convert the REAL
+  // kg/lbs columns in place. Set volumes are recomputed from the rounded
+  // weights, and log totals from the sets, so every total stays exact.
+  const char* sql =
+      "BEGIN;"
+      "ALTER TABLE training_sets ADD COLUMN weight_g INTEGER NOT NULL "
+      "DEFAULT 0;"
+      "ALTER TABLE training_sets ADD COLUMN volume_g INTEGER NOT NULL "
+      "DEFAULT 0;"
+      "ALTER TABLE training_sets ADD COLUMN elastic_band_g INTEGER DEFAULT 0;"
+      "UPDATE training_sets SET "
+      "  weight_g = CAST(ROUND(weight * 1000) AS INTEGER),"
+      "  volume_g = CAST(ROUND(weight * 1000) AS INTEGER) * reps,"
+      "  elastic_band_g = CAST(ROUND(elastic_band_weight * 453.59237) AS "
+      "INTEGER);"
+      "ALTER TABLE training_sets DROP COLUMN weight;"
+      "ALTER TABLE training_sets DROP COLUMN volume;"
+      "ALTER TABLE training_sets DROP COLUMN elastic_band_weight;"
+      "ALTER TABLE training_logs ADD COLUMN total_volume_g INTEGER NOT NULL "
+      "DEFAULT 0;"
+      "UPDATE training_logs SET total_volume_g = "
+      "  (SELECT COALESCE(SUM(s.volume_g), 0) FROM training_sets s "
+      "   WHERE s.log_id = training_logs.id);"
+      "ALTER TABLE training_logs DROP COLUMN total_volume;"
+      "COMMIT;";
+
+  char* z_err_msg = nullptr;
+  if (sqlite3_exec(db_, sql, nullptr, nullptr, &z_err_msg) != SQLITE_OK) {
+    std::cerr << "SQL error migrating weights to grams: " << z_err_msg
+              << std::endl;
+    sqlite3_free(z_err_msg);
+    sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+    return false;
+  }
+  std::cout << "Migrated weights to integer grams." << std::endl;
+  return true;
+}
+
+auto DbManager::MigrateLogSources() -> bool {
+  if (HasColumn("training_logs", "source_id")) {
+    return true;
+  }
+
+  // Databases whose checkpoints found a source's rows by cycle_id and id
+  // alone. Each row goes to the checkpoint of its cycle with the nearest
+  // first_log_id at or before it, the best that layout allows: a source
+  // resumed after another one with the same first date was ingested cannot
+  // be told apart from it any more.
+  const char* sql =
+      "BEGIN;"
+      "ALTER TABLE training_logs ADD COLUMN source_id INTEGER;"
+      "INSERT OR IGNORE INTO ingest_sources (source) "
+      "  SELECT source FROM ingest_checkpoints;"
+      "UPDATE training_logs SET source_id = "
+      "  (SELECT s.id FROM ingest_checkpoints AS c "
+      "   JOIN ingest_sources AS s ON s.source = c.source "
+      "   WHERE c.cycle_id = training_logs.cycle_id "
+      "     AND c.first_log_id <= training_logs.id "
+      "   ORDER BY c.first_log_id DESC LIMIT 1) "
+      "WHERE EXISTS (SELECT 1 FROM ingest_checkpoints);"
+      "COMMIT;";
+
+  char* z_err_msg = nullptr;
+  if (sqlite3_exec(db_, sql, nullptr, nullptr, &z_err_msg) != SQLITE_OK) {
+    std::cerr << "SQL error adding log sources: " << z_err_msg << std::endl;
+    sqlite3_free(z_err_msg);
+    sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+    return false;
+  }
+  std::cout << "Added source_id column to training_logs." << std::endl;
+  return true;
+}
+
+auto DbManager::MigrateDatesToDays() -> bool {
+  if (ColumnType("training_logs", "date") != "TEXT") {
+    return true;
+  }
+
+  // Databases written before dates became day numbers: rebuild
+  // training_logs with INTEGER cycle_id/date columns. Ids are kept, so
+  // training_sets.log_id stays valid. julianday() of 1970-01-01 is 2440587.5.
+  const std::string sql =
+      "BEGIN;"
+      "CREATE TABLE training_logs_days " +
+      std::string(kTrainingLogsColumns) +
+      ";"
+      "INSERT INTO training_logs_days (id, cycle_id, total_days, date, "
+      "  daily_note, project_note, exercise_name, exercise_type, "
+      "  total_volume_g, exercise_code, source_id) "
+      "SELECT id, CAST(julianday(cycle_id) - 2440587.5 AS INTEGER), "
+      "  total_days, CAST(julianday(date) - 2440587.5 AS INTEGER), "
+      "  daily_note, project_note, exercise_name, exercise_type, "
+      "  total_volume_g, exercise_code, source_id "
+      "FROM training_logs;"
+      "DROP TABLE training_logs;"
+      "ALTER TABLE training_logs_days RENAME TO training_logs;"
+      "COMMIT;";
+
+  char* z_err_msg = nullptr;
+  if (sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, &z_err_msg) !=
+      SQLITE_OK) {
+    std::cerr << "SQL error migrating dates to day numbers: " << z_err_msg
+              << std::endl;
+    sqlite3_free(z_err_msg);
+    sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+    return false;
+  }
+  std::cout << "Migrated dates to day numbers." << std::endl;
+  return true;
+}
+
+auto DbManager::CreateIndexes() -> bool {
+  // Cycle lookups and date ranges become index range scans on integers.
+  // Once a query starts from a cycle's logs, their sets must be found by
+  // log_id as well, or every log row rescans training_sets. Remapping
+  // visits the rows of each exercise code, and a resumed ingest the latest
+  // rows of one source.
+  const char* sql =
+      "CREATE INDEX IF NOT EXISTS idx_training_logs_cycle_date "
+      "ON training_logs (cycle_id, date);"
+      "CREATE INDEX IF NOT EXISTS idx_training_logs_code "
+      "ON training_logs (exercise_code);"
+      "CREATE INDEX IF NOT EXISTS idx_training_logs_source "
+      "ON training_logs (source_id);"
+      "CREATE INDEX IF NOT EXISTS idx_training_sets_log "
+      "ON training_sets (log_id, set_number);";
+
+  char* z_err_msg = nullptr;
+  if (sqlite3_exec(db_, sql, nullptr, nullptr, &z_err_msg) != SQLITE_OK) {
+    std::cerr << "SQL error creating indexes: " << z_err_msg << std::endl;
+    sqlite3_free(z_err_msg);
+    return false;
+  }
+  return true;
 }
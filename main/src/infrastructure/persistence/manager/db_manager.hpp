@@ -4,7 +4,9 @@
 #define DB_MANAGER_DB_MANAGER_HPP_
 
 #include "sqlite3.h"
+#include <optional>
 #include <string>
+#include <string_view>
 
 class DbManager {
 public:
@@ -24,6 +26,21 @@ private:
   sqlite3* db_ = nullptr;
   
   auto CreateTables() -> bool;
+  // Declared type of the column, or nullopt if the table lacks it
+  [[nodiscard]] auto ColumnType(std::string_view table_name,
+                                std::string_view column_name) const
+      -> std::optional<std::string>;
+  [[nodiscard]] auto HasColumn(std::string_view table_name,
+                               std::string_view column_name) const -> bool;
+  // Converts a pre-fixed-point database (REAL kg/lbs columns) to the integer
+  // gram columns; a no-op on current databases
+  auto MigrateWeightsToGrams() -> bool;
+  // Adds training_logs.source_id and assigns the rows of existing
+  // checkpoints to their sources
+  auto MigrateLogSources() -> bool;
+  // Converts TEXT "YYYY-MM-DD" cycle_id/date columns to day numbers
+  auto MigrateDatesToDays() -> bool;
+  auto CreateIndexes() -> bool;
 };
 
 #endif // DB_MANAGER_DB_MANAGER_HPP_
\ No newline at end of file
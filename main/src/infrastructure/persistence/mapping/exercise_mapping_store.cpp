@@ -0,0 +1,142 @@
+// db/mapping/exercise_mapping_store.cpp
+
+#include "infrastructure/persistence/mapping/exercise_mapping_store.hpp"
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+auto Prepare(sqlite3* db, const char* sql) -> sqlite3_stmt* {
+  sqlite3_stmt* stmt = nullptr;
+  if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+    throw std::runtime_error("Failed to prepare statement: " +
+                             std::string(sqlite3_errmsg(db)));
+  }
+  return stmt;
+}
+
+auto BindText(sqlite3_stmt* stmt, int index, std::string_view text) -> void {
+  sqlite3_bind_text(stmt, index, text.data(), static_cast<int>(text.size()),
+                    SQLITE_TRANSIENT);
+}
+
+// Steps a statement that returns no rows and finalizes it.
+auto Run(sqlite3* db, sqlite3_stmt* stmt, const char* what) -> void {
+  const int kResult = sqlite3_step(stmt);
+  sqlite3_finalize(stmt);
+  if (kResult != SQLITE_DONE) {
+    throw std::runtime_error(std::string(what) + ": " +
+                             std::string(sqlite3_errmsg(db)));
+  }
+}
+
+}  // namespace
+
+ExerciseMappingStore::ExerciseMappingStore(sqlite3* db_handle)
+    : db_(db_handle) {}
+
+auto ExerciseMappingStore::RecordCycle(sqlite3_int64 source_id,
+                                       sqlite3_int64 first_log_id) -> void {
+  sqlite3_stmt* stmt = Prepare(
+      db_,
+      "INSERT OR REPLACE INTO exercise_mappings "
+      "(code, exercise_name, exercise_type) "
+      "SELECT DISTINCT exercise_code, exercise_name, exercise_type "
+      "FROM training_logs "
+      "WHERE source_id IS ? AND id >= ? AND exercise_code IS NOT NULL;");
+  // 0 stands for no source; left unbound, the parameter is NULL.
+  if (source_id != 0) {
+    sqlite3_bind_int64(stmt, 1, source_id);
+  }
+  sqlite3_bind_int64(stmt, 2, first_log_id);
+  Run(db_, stmt, "Error recording exercise mappings");
+}
+
+auto ExerciseMappingStore::Replace(const ProjectNameMapper& mapper)
+    -> sqlite3_int64 {
+  Run(db_, Prepare(db_, "DELETE FROM exercise_mappings;"),
+      "Error clearing exercise mappings");
+
+  sqlite3_stmt* stmt = Prepare(
+      db_,
+      "INSERT OR REPLACE INTO exercise_mappings "
+      "(code, exercise_name, exercise_type) VALUES (?, ?, ?);");
+  sqlite3_int64 count = 0;
+  // ForEach cannot be stopped early, so the first failure skips the rest.
+  std::optional<std::string> error;
+  mapper.ForEach([&](std::string_view short_name,
+                     const ProjectMappingView& mapping) -> void {
+    if (error) {
+      return;
+    }
+    BindText(stmt, 1, short_name);
+    BindText(stmt, 2, mapping.full_name);
+    BindText(stmt, 3, mapping.type);
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+      error = sqlite3_errmsg(db_);
+      return;
+    }
+    sqlite3_reset(stmt);
+    ++count;
+  });
+  sqlite3_finalize(stmt);
+  if (error) {
+    throw std::runtime_error("Error storing exercise mappings: " + *error);
+  }
+  return count;
+}
+
+auto ExerciseMappingStore::BackfillCodes() -> sqlite3_int64 {
+  // A name and type shared by several codes cannot be traced back; such
+  // rows keep their NULL code.
+  sqlite3_stmt* stmt = Prepare(
+      db_,
+      "UPDATE training_logs SET exercise_code = unique_names.code "
+      "FROM (SELECT exercise_name, exercise_type, MIN(code) AS code "
+      "      FROM exercise_mappings "
+      "      GROUP BY exercise_name, exercise_type HAVING COUNT(*) = 1) "
+      "  AS unique_names "
+      "WHERE training_logs.exercise_code IS NULL "
+      "  AND training_logs.exercise_name = unique_names.exercise_name "
+      "  AND training_logs.exercise_type = unique_names.exercise_type;");
+  Run(db_, stmt, "Error backfilling exercise codes");
+  return sqlite3_changes64(db_);
+}
+
+auto ExerciseMappingStore::ApplyToLogs() -> sqlite3_int64 {
+  // One pass per distinct code: the codes in use are read off the index,
+  // each is looked up in the mapping, and its rows are found through the
+  // index again. Rows that already hold the right name and type are not
+  // written, so a rename touches only the rows of that exercise.
+  sqlite3_stmt* stmt = Prepare(
+      db_,
+      "UPDATE training_logs "
+      "SET exercise_name = mapped.exercise_name, "
+      "    exercise_type = mapped.exercise_type "
+      "FROM (SELECT codes.code AS code, "
+      "        COALESCE(m.exercise_name, codes.code) AS exercise_name, "
+      "        COALESCE(m.exercise_type, 'unknown') AS exercise_type "
+      "      FROM (SELECT DISTINCT exercise_code AS code FROM training_logs "
+      "            WHERE exercise_code IS NOT NULL) AS codes "
+      "      LEFT JOIN exercise_mappings AS m ON m.code = codes.code) "
+      "  AS mapped "
+      "WHERE training_logs.exercise_code = mapped.code "
+      "  AND (training_logs.exercise_name IS NOT mapped.exercise_name "
+      "       OR training_logs.exercise_type IS NOT mapped.exercise_type);");
+  Run(db_, stmt, "Error remapping training logs");
+  return sqlite3_changes64(db_);
+}
+
+auto ExerciseMappingStore::CountUncodedLogs() const -> sqlite3_int64 {
+  sqlite3_stmt* stmt = Prepare(
+      db_, "SELECT COUNT(*) FROM training_logs WHERE exercise_code IS NULL;");
+  sqlite3_int64 count = 0;
+  if (sqlite3_step(stmt) == SQLITE_ROW) {
+    count = sqlite3_column_int64(stmt, 0);
+  }
+  sqlite3_finalize(stmt);
+  return count;
+}
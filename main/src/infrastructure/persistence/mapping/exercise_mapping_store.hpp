@@ -0,0 +1,58 @@
+// db/mapping/exercise_mapping_store.hpp
+
+#ifndef DB_MAPPING_EXERCISE_MAPPING_STORE_HPP_
+#define DB_MAPPING_EXERCISE_MAPPING_STORE_HPP_
+
+#include "infrastructure/converter/project_name_mapper.hpp"
+#include "sqlite3.h"
+
+/**
+ * @brief exercise_mappings 表: 简称 -> 名称与类型。
+ *
+ * training_logs 的每一行保存日志中写的简称 (exercise_code) 以及映射后的
+ * 名称与类型; 查询与报表直接读取后两列。映射改变后, 先用新映射替换本表,
+ * 再由一条 UPDATE 把它联结回 training_logs, 无需重新导入日志。
+ */
+class ExerciseMappingStore {
+public:
+  explicit ExerciseMappingStore(sqlite3* db_handle);
+
+  /**
+   * @brief 记录刚写入的一个周期所使用的映射: 源文件 source_id (无源文件时为
+   *        DataInserter::kNoSource) 中 id 不小于 first_log_id 的行。
+   * @throws std::runtime_error 写入失败时。
+   */
+  auto RecordCycle(sqlite3_int64 source_id, sqlite3_int64 first_log_id)
+      -> void;
+
+  /**
+   * @brief 用 mapper 的全部映射替换表中内容。
+   * @return 写入的映射数。
+   * @throws std::runtime_error 写入失败时。
+   */
+  auto Replace(const ProjectNameMapper& mapper) -> sqlite3_int64;
+
+  /**
+   * @brief 为没有简称的旧日志行补上简称: 名称与类型恰好对应表中一个映射时,
+   *        取该映射的简称。
+   * @return 补上简称的行数。
+   * @throws std::runtime_error 更新失败时。
+   */
+  auto BackfillCodes() -> sqlite3_int64;
+
+  /**
+   * @brief 按表中映射改写所有带简称的日志行; 表中没有的简称与转换时一样
+   *        映射为其本身, 类型为 "unknown"。只写入确实改变的行。
+   * @return 改变的行数。
+   * @throws std::runtime_error 更新失败时。
+   */
+  auto ApplyToLogs() -> sqlite3_int64;
+
+  // 在记录简称之前写入的日志行数; 这些行不会被 ApplyToLogs() 改写
+  [[nodiscard]] auto CountUncodedLogs() const -> sqlite3_int64;
+
+private:
+  sqlite3* db_;
+};
+
+#endif // DB_MAPPING_EXERCISE_MAPPING_STORE_HPP_
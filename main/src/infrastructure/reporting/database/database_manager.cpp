@@ -4,16 +4,18 @@
 
 #include <iostream>
 
+#include "domain/services/date_service.hpp"
+
 auto DatabaseManager::QueryAllLogs(sqlite3* sqlite_db)
-    -> std::map<std::string, CycleData> {
+    -> std::map<std::chrono::sys_days, CycleData> {
   std::cout << "Querying data from database..." << std::endl;
-  std::map<std::string, CycleData> data_by_cycle;
+  std::map<std::chrono::sys_days, CycleData> data_by_cycle;
   sqlite3_stmt* stmt = nullptr;
 
   const char* sql =
       "SELECT l.cycle_id, l.total_days, l.exercise_type, l.id, "
       "l.date, l.exercise_name, l.daily_note, l.project_note, "
-      "s.reps, s.weight, s.unit, s.elastic_band_weight, "
+      "s.reps, s.weight_g, s.unit, s.elastic_band_g, "
       "s.set_note "
       "FROM training_logs l "
       "JOIN training_sets s ON l.id = s.log_id "
@@ -42,24 +44,25 @@ auto DatabaseManager::QueryAllLogs(sqlite3* sqlite_db)
     constexpr int kColElasticBandWeight = 11;
     constexpr int kColSetNote = 12;
 
-    std::string cycle_id =
-        reinterpret_cast<const char*>(sqlite3_column_text(stmt, kColCycleId));
+    const std::chrono::sys_days kCycleId =
+        DateService::FromDayNumber(sqlite3_column_int64(stmt, kColCycleId));
     int total_days = sqlite3_column_int(stmt, kColTotalDays);
     std::string type =
         reinterpret_cast<const char*>(sqlite3_column_text(stmt, kColType));
     long long log_id = sqlite3_column_int64(stmt, kColLogId);
 
-    if (!data_by_cycle.contains(cycle_id)) {
-      data_by_cycle[cycle_id].total_days_ = total_days;
-      data_by_cycle[cycle_id].type_ = type;
+    if (!data_by_cycle.contains(kCycleId)) {
+      data_by_cycle[kCycleId].total_days_ = total_days;
+      data_by_cycle[kCycleId].type_ = type;
     }
 
     if (!temp_entries.contains(log_id)) {
+      SymbolTable& symbols = data_by_cycle[kCycleId].symbols_;
       LogEntry entry;
       entry.date_ =
-          reinterpret_cast<const char*>(sqlite3_column_text(stmt, kColDate));
-      entry.exercise_name_ = reinterpret_cast<const char*>(
-          sqlite3_column_text(stmt, kColExerciseName));
+          DateService::FromDayNumber(sqlite3_column_int64(stmt, kColDate));
+      entry.exercise_name_ = symbols.Intern(reinterpret_cast<const char*>(
+          sqlite3_column_text(stmt, kColExerciseName)));
       const unsigned char* note_text = sqlite3_column_text(stmt, kColDailyNote);
       entry.daily_note_ = (note_text != nullptr)
                               ? reinterpret_cast<const char*>(note_text)
@@ -70,21 +73,20 @@ auto DatabaseManager::QueryAllLogs(sqlite3* sqlite_db)
           (project_note_text != nullptr)
               ? reinterpret_cast<const char*>(project_note_text)
               : "";
-      entry.exercise_type_ = type;
+      entry.exercise_type_ = symbols.Intern(type.empty() ? "unknown" : type);
       temp_entries[log_id] = entry;
     }
 
     SetDetail detail;
     detail.reps_ = sqlite3_column_int(stmt, kColReps);
-    detail.weight_ = sqlite3_column_double(stmt, kColWeight);
+    detail.weight_g_ = sqlite3_column_int(stmt, kColWeight);
 
     const unsigned char* unit_text = sqlite3_column_text(stmt, kColUnit);
     detail.unit_ = (unit_text != nullptr)
                        ? reinterpret_cast<const char*>(unit_text)
                        : "kg";
 
-    detail.elastic_band_weight_ =
-        sqlite3_column_double(stmt, kColElasticBandWeight);
+    detail.elastic_band_g_ = sqlite3_column_int(stmt, kColElasticBandWeight);
     const unsigned char* set_note_text = sqlite3_column_text(stmt, kColSetNote);
     detail.note_ = (set_note_text != nullptr)
                        ? reinterpret_cast<const char*>(set_note_text)
@@ -95,16 +97,16 @@ auto DatabaseManager::QueryAllLogs(sqlite3* sqlite_db)
 
   if (sqlite3_prepare_v2(sqlite_db, "SELECT id, cycle_id FROM training_logs",
                          -1, &stmt, nullptr) == SQLITE_OK) {
-    std::map<long long, std::string> log_to_cycle_map;
+    std::map<long long, std::chrono::sys_days> log_to_cycle_map;
     while (sqlite3_step(stmt) == SQLITE_ROW) {
       log_to_cycle_map[sqlite3_column_int64(stmt, 0)] =
-          reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+          DateService::FromDayNumber(sqlite3_column_int64(stmt, 1));
     }
 
     for (const auto& [log_id, entry] : temp_entries) {
       if (log_to_cycle_map.contains(log_id)) {
-        const std::string& cycle_id = log_to_cycle_map.at(log_id);
-        data_by_cycle[cycle_id].logs_.push_back(entry);
+        const std::chrono::sys_days kCycleId = log_to_cycle_map.at(log_id);
+        data_by_cycle[kCycleId].logs_.push_back(entry);
       }
     }
   }
@@ -113,14 +115,12 @@ auto DatabaseManager::QueryAllLogs(sqlite3* sqlite_db)
   // Fetch advanced metrics for each cycle
   for (auto& [cycle_id, cycle_data] : data_by_cycle) {
     const char* stats_sql =
-        "SELECT SUM(s.weight * s.reps), "
-        "CAST(SUM(s.weight * s.reps) AS DOUBLE) / SUM(s.reps), "
+        "SELECT SUM(s.volume_g), "
+        "CAST(SUM(s.volume_g) AS DOUBLE) / SUM(s.reps), "
         "COUNT(DISTINCT l.id), "
-        "SUM(CASE WHEN s.reps BETWEEN 1 AND 5 THEN s.weight * s.reps ELSE 0 "
-        "END), "
-        "SUM(CASE WHEN s.reps BETWEEN 6 AND 12 THEN s.weight * s.reps ELSE 0 "
-        "END), "
-        "SUM(CASE WHEN s.reps >= 13 THEN s.weight * s.reps ELSE 0 END) "
+        "SUM(CASE WHEN s.reps BETWEEN 1 AND 5 THEN s.volume_g ELSE 0 END), "
+        "SUM(CASE WHEN s.reps BETWEEN 6 AND 12 THEN s.volume_g ELSE 0 END), "
+        "SUM(CASE WHEN s.reps >= 13 THEN s.volume_g ELSE 0 END) "
         "FROM training_logs l "
         "JOIN training_sets s ON l.id = s.log_id "
         "WHERE l.cycle_id = ? "
@@ -128,7 +128,7 @@ auto DatabaseManager::QueryAllLogs(sqlite3* sqlite_db)
 
     if (sqlite3_prepare_v2(sqlite_db, stats_sql, -1, &stmt, nullptr) ==
         SQLITE_OK) {
-      sqlite3_bind_text(stmt, 1, cycle_id.c_str(), -1, SQLITE_STATIC);
+      sqlite3_bind_int64(stmt, 1, DateService::ToDayNumber(cycle_id));
       if (sqlite3_step(stmt) == SQLITE_ROW) {
         constexpr int kColTotalVolume = 0;
         constexpr int kColAvgIntensity = 1;
@@ -137,15 +137,19 @@ auto DatabaseManager::QueryAllLogs(sqlite3* sqlite_db)
         constexpr int kColVolumeHypertrophy = 4;
         constexpr int kColVolumeEndurance = 5;
 
-        cycle_data.total_volume_ = sqlite3_column_double(stmt, kColTotalVolume);
+        // 容量以整数 克·次 求和, 仅在此处换算为 kg
+        cycle_data.total_volume_ =
+            Weight::ToKg(sqlite3_column_int64(stmt, kColTotalVolume));
         cycle_data.average_intensity_ =
-            sqlite3_column_double(stmt, kColAvgIntensity);
+            sqlite3_column_double(stmt, kColAvgIntensity) /
+            Weight::kGramsPerKg;
         cycle_data.session_count_ = sqlite3_column_int(stmt, kColSessionCount);
-        cycle_data.vol_power_ = sqlite3_column_double(stmt, kColVolumePower);
+        cycle_data.vol_power_ =
+            Weight::ToKg(sqlite3_column_int64(stmt, kColVolumePower));
         cycle_data.vol_hypertrophy_ =
-            sqlite3_column_double(stmt, kColVolumeHypertrophy);
+            Weight::ToKg(sqlite3_column_int64(stmt, kColVolumeHypertrophy));
         cycle_data.vol_endurance_ =
-            sqlite3_column_double(stmt, kColVolumeEndurance);
+            Weight::ToKg(sqlite3_column_int64(stmt, kColVolumeEndurance));
       }
       sqlite3_finalize(stmt);
     }
@@ -158,7 +162,7 @@ auto DatabaseManager::QueryAllLogs(sqlite3* sqlite_db)
 auto DatabaseManager::QueryPRSummary(sqlite3* sqlite_db)
     -> std::vector<PRRecord> {
   const char* sql =
-      "SELECT exercise_name, MAX(weight), reps, date "
+      "SELECT exercise_name, MAX(weight_g), reps, date "
       "FROM training_logs l JOIN training_sets s ON l.id = s.log_id "
       "GROUP BY exercise_name "
       "ORDER BY exercise_name ASC;";
@@ -170,10 +174,9 @@ auto DatabaseManager::QueryPRSummary(sqlite3* sqlite_db)
       PRRecord record;
       record.exercise_name_ =
           reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-      record.max_weight_ = sqlite3_column_double(stmt, 1);
+      record.max_weight_ = Weight::ToKg(sqlite3_column_int64(stmt, 1));
       record.reps_ = sqlite3_column_int(stmt, 2);
-      record.date_ =
-          reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+      record.date_ = DateService::FromDayNumber(sqlite3_column_int64(stmt, 3));
 
       // Basic 1RM calculation logic (epley & brzycki)
       if (record.reps_ > 1) {
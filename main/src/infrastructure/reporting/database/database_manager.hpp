@@ -3,7 +3,10 @@
 #ifndef REPORT_DATABASE_DATABASE_MANAGER_HPP_
 #define REPORT_DATABASE_DATABASE_MANAGER_HPP_
 
+#include "common/symbol_table.hpp"
+#include "domain/models/weight.hpp"
 #include "sqlite3.h"
+#include <chrono>
 #include <map>
 #include <string>
 #include <vector>
@@ -11,18 +14,18 @@
 // 定义每一组的详细数据
 struct SetDetail {
   int reps_;
-  double weight_;
+  Weight::Grams weight_g_;        // 重量 (克)
   std::string unit_;
-  double elastic_band_weight_;
+  Weight::Grams elastic_band_g_;  // 弹力带助力 (克), 以 unit_ 显示
   std::string note_;
 };
 
 struct LogEntry {
-  std::string date_;
+  std::chrono::sys_days date_;
   std::string daily_note_;
   std::string project_note_;
-  std::string exercise_name_;
-  std::string exercise_type_;
+  SymbolId exercise_name_;  // CycleData::symbols_ 中的 id
+  SymbolId exercise_type_;  // 空类型已归一为 "unknown"
   std::vector<SetDetail> sets_;
 };
 
@@ -36,13 +39,14 @@ struct CycleData {
   double vol_endurance_ = 0.0;
   double total_volume_ = 0.0;
   std::vector<LogEntry> logs_;
+  SymbolTable symbols_;  // logs_ 中动作名称与类型的字符串
 };
 
 struct PRRecord {
   std::string exercise_name_;
   double max_weight_;
   int reps_;
-  std::string date_;
+  std::chrono::sys_days date_;
   double estimated_1rm_epley_;
   double estimated_1rm_brzycki_;
 };
@@ -52,9 +56,10 @@ public:
   /**
    * @brief 从数据库查询所有的训练日志，并按 cycle_id 分组。
    * @param db sqlite3数据库连接的指针。
-   * @return 按 cycle_id 分组的日志数据。
+   * @return 按 cycle_id (周期首日) 分组的日志数据。
    */
-  static auto QueryAllLogs(sqlite3* sqlite_db) -> std::map<std::string, CycleData>;
+  static auto QueryAllLogs(sqlite3* sqlite_db)
+      -> std::map<std::chrono::sys_days, CycleData>;
   /**
    * @brief 查询所有动作的个人记录 (PR)。
    */
@@ -3,7 +3,6 @@
 #include "infrastructure/reporting/formatter/markdown_formatter.hpp"
 
 #include <algorithm>
-#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -12,19 +11,20 @@
 #include <sstream>
 #include <vector>
 
+#include "domain/services/date_service.hpp"
+
 namespace fs = std::filesystem;
 
 auto MarkdownFormatter::GroupSets(const std::vector<SetDetail>& sets)
     -> std::vector<SetGroup> {
   std::vector<SetGroup> groups;
 
-  constexpr double kEpsilon = 0.001;
+  // Weights are integer grams, so equal loads compare exactly
   auto is_same_load = [](const SetDetail& set_detail,
                          const SetGroup& set_group) -> bool {
-    return std::abs(set_detail.weight_ - set_group.weight_) < kEpsilon &&
+    return set_detail.weight_g_ == set_group.weight_g_ &&
            set_detail.unit_ == set_group.unit_ &&
-           std::abs(set_detail.elastic_band_weight_ - set_group.elastic_band_) <
-               kEpsilon &&
+           set_detail.elastic_band_g_ == set_group.elastic_band_g_ &&
            set_detail.note_ == set_group.note_;
   };
 
@@ -33,12 +33,12 @@ auto MarkdownFormatter::GroupSets(const std::vector<SetDetail>& sets)
       groups.back().reps_list_.push_back(set_item.reps_);
     } else {
       SetGroup group;
-      group.weight_ = set_item.weight_;
+      group.weight_g_ = set_item.weight_g_;
       group.unit_ = set_item.unit_;
-      group.elastic_band_ = set_item.elastic_band_weight_;
+      group.elastic_band_g_ = set_item.elastic_band_g_;
       group.note_ = set_item.note_;
       group.reps_list_ = {set_item.reps_};
-      group.volume_ = 0.0;
+      group.volume_g_ = 0;
       group.estimated_1rm_ = 0.0;
       groups.push_back(group);
     }
@@ -48,13 +48,14 @@ auto MarkdownFormatter::GroupSets(const std::vector<SetDetail>& sets)
   for (auto& group : groups) {
     int max_reps = 0;
     for (int reps : group.reps_list_) {
-      group.volume_ += group.weight_ * reps;
+      group.volume_g_ += static_cast<Weight::GramReps>(group.weight_g_) * reps;
       max_reps = std::max(max_reps, reps);
     }
+    const double kWeight = Weight::ToKg(group.weight_g_);
     if (max_reps > 1) {
-      group.estimated_1rm_ = group.weight_ * (1.0 + max_reps / 30.0);
+      group.estimated_1rm_ = kWeight * (1.0 + max_reps / 30.0);
     } else {
-      group.estimated_1rm_ = group.weight_;
+      group.estimated_1rm_ = kWeight;
     }
   }
 
@@ -62,8 +63,9 @@ auto MarkdownFormatter::GroupSets(const std::vector<SetDetail>& sets)
 }
 
 auto MarkdownFormatter::FormatExercise(std::ostream& md_file,
-                                       const LogEntry& log) -> void {
-  md_file << "  - **" << log.exercise_name_ << "**\n";
+                                       const LogEntry& log,
+                                       const SymbolTable& symbols) -> void {
+  md_file << "  - **" << symbols.Resolve(log.exercise_name_) << "**\n";
   if (!log.project_note_.empty()) {
     md_file << "    - **Note:** " << log.project_note_ << "\n";
   }
@@ -74,13 +76,16 @@ auto MarkdownFormatter::FormatExercise(std::ostream& md_file,
 
   auto groups = GroupSets(log.sets_);
 
-  constexpr double kEpsilon = 0.001;
   for (const auto& group : groups) {
     std::stringstream report_stream;
-    if (group.elastic_band_ > kEpsilon) {
-      report_stream << "-" << group.elastic_band_ << group.unit_;
+    if (group.elastic_band_g_ > 0) {
+      report_stream << "-"
+                    << (group.unit_ == "lbs"
+                            ? Weight::ToLbs(group.elastic_band_g_)
+                            : Weight::ToKg(group.elastic_band_g_))
+                    << group.unit_;
     } else {
-      report_stream << group.weight_ << group.unit_;
+      report_stream << Weight::ToKg(group.weight_g_) << group.unit_;
     }
 
     report_stream << " x [";
@@ -93,8 +98,8 @@ auto MarkdownFormatter::FormatExercise(std::ostream& md_file,
     report_stream << "]";
 
     md_file << "    - `" << report_stream.str() << "`";
-    md_file << " (Vol: " << std::fixed << std::setprecision(1) << group.volume_
-            << "kg";
+    md_file << " (Vol: " << std::fixed << std::setprecision(1)
+            << Weight::ToKg(group.volume_g_) << "kg";
     if (group.reps_list_[0] > 1 || group.reps_list_.size() > 1) {
       md_file << ", e1RM: " << group.estimated_1rm_ << "kg";
     }
@@ -107,7 +112,7 @@ auto MarkdownFormatter::FormatExercise(std::ostream& md_file,
 }
 
 auto MarkdownFormatter::ExportToMarkdown(
-    const std::map<std::string, CycleData>& data_by_cycle,
+    const std::map<std::chrono::sys_days, CycleData>& data_by_cycle,
     const std::vector<PRRecord>& prs, const std::string& output_dir) -> bool {
   std::cout << "Exporting data to Markdown files (Enhanced Reporting System)..."
             << std::endl;
@@ -131,10 +136,11 @@ auto MarkdownFormatter::ExportToMarkdown(
   return true;
 }
 
-auto MarkdownFormatter::ProcessCycle(const std::string& cycle_id,
+auto MarkdownFormatter::ProcessCycle(std::chrono::sys_days cycle_id,
                                      const CycleData& cycle_data,
                                      const std::string& output_dir) -> void {
-  fs::path cycle_dir = fs::path(output_dir) / cycle_id;
+  const std::string kCycleName = DateService::Format(cycle_id);
+  fs::path cycle_dir = fs::path(output_dir) / kCycleName;
   try {
     fs::create_directories(cycle_dir);
   } catch (const fs::filesystem_error& e) {
@@ -143,24 +149,34 @@ auto MarkdownFormatter::ProcessCycle(const std::string& cycle_id,
     return;
   }
 
-  std::cout << "  -> Processing Cycle: " << cycle_id
+  std::cout << "  -> Processing Cycle: " << kCycleName
             << " into folder: " << cycle_dir << std::endl;
 
-  std::map<std::string, std::vector<LogEntry>> logs_by_type;
+  // Bucket by interned type id; entries are referenced, not copied.
+  const SymbolTable& symbols = cycle_data.symbols_;
+  std::vector<std::vector<const LogEntry*>> logs_by_type(symbols.Size());
   for (const auto& log : cycle_data.logs_) {
-    std::string type_key =
-        log.exercise_type_.empty() ? "unknown" : log.exercise_type_;
-    logs_by_type[type_key].push_back(log);
+    logs_by_type[log.exercise_type_].push_back(&log);
+  }
+
+  std::vector<SymbolId> type_ids;
+  for (SymbolId type_id = 0; type_id < logs_by_type.size(); ++type_id) {
+    if (!logs_by_type[type_id].empty()) {
+      type_ids.push_back(type_id);
+    }
   }
+  std::ranges::sort(type_ids, {}, [&](SymbolId type_id) -> std::string_view {
+    return symbols.Resolve(type_id);
+  });
 
-  for (const auto& [type, type_logs] : logs_by_type) {
-    ProcessType({.cycle_id = cycle_id, .type = type}, type_logs, cycle_data,
-                cycle_dir);
+  for (SymbolId type_id : type_ids) {
+    ProcessType({.cycle_id = cycle_id, .type = symbols.Resolve(type_id)},
+                logs_by_type[type_id], cycle_data, cycle_dir);
   }
 }
 
 auto MarkdownFormatter::ProcessType(const ReportParams& params,
-                                    const std::vector<LogEntry>& type_logs,
+                                    const std::vector<const LogEntry*>& type_logs,
                                     const CycleData& cycle_data,
                                     const std::filesystem::path& cycle_dir)
     -> void {
@@ -178,7 +194,8 @@ auto MarkdownFormatter::ProcessType(const ReportParams& params,
   }
 
   md_file << "# " << display_title << " Training Report\n\n";
-  md_file << "**Cycle:** `" << params.cycle_id << "`\n\n";
+  md_file << "**Cycle:** `" << DateService::Format(params.cycle_id)
+          << "`\n\n";
 
   // Fixed Kinematics Dashboard
   md_file << "## 📊 Kinematics Dashboard\n";
@@ -209,25 +226,27 @@ auto MarkdownFormatter::ProcessType(const ReportParams& params,
 
   md_file << "---\n\n";
 
-  std::map<std::string, std::vector<LogEntry>> daily_logs_for_type;
-  for (const auto& log : type_logs) {
-    daily_logs_for_type[log.date_].push_back(log);
+  std::map<std::chrono::sys_days, std::vector<const LogEntry*>>
+      daily_logs_for_type;
+  for (const LogEntry* log : type_logs) {
+    daily_logs_for_type[log->date_].push_back(log);
   }
 
   for (const auto& [date, daily_entries] : daily_logs_for_type) {
-    ProcessDateGroup(md_file, date, daily_entries);
+    ProcessDateGroup(md_file, date, daily_entries, cycle_data.symbols_);
   }
 }
 
 auto MarkdownFormatter::ProcessDateGroup(
-    std::ofstream& md_file, const std::string& date,
-    const std::vector<LogEntry>& daily_entries) -> void {
-  md_file << "## " << date << "\n\n";
+    std::ofstream& md_file, std::chrono::sys_days date,
+    const std::vector<const LogEntry*>& daily_entries,
+    const SymbolTable& symbols) -> void {
+  md_file << "## " << DateService::Format(date) << "\n\n";
 
   std::string daily_note;
-  for (const auto& log : daily_entries) {
-    if (!log.daily_note_.empty()) {
-      daily_note = log.daily_note_;
+  for (const LogEntry* log : daily_entries) {
+    if (!log->daily_note_.empty()) {
+      daily_note = log->daily_note_;
       break;
     }
   }
@@ -235,8 +254,8 @@ auto MarkdownFormatter::ProcessDateGroup(
     md_file << "**Note:** " << daily_note << "\n\n";
   }
 
-  for (const auto& log : daily_entries) {
-    FormatExercise(md_file, log);
+  for (const LogEntry* log : daily_entries) {
+    FormatExercise(md_file, *log, symbols);
   }
   md_file << "\n---\n\n";
 }
@@ -263,7 +282,7 @@ auto MarkdownFormatter::ExportSummary(const std::vector<PRRecord>& prs,
   for (const auto& pr : prs) {
     md_file << "| **" << pr.exercise_name_ << "** | " << std::fixed
             << std::setprecision(1) << pr.max_weight_ << " kg | " << pr.reps_
-            << " | " << pr.date_ << " | " << pr.estimated_1rm_epley_ << " kg | "
+            << " | " << DateService::Format(pr.date_) << " | " << pr.estimated_1rm_epley_ << " kg | "
             << pr.estimated_1rm_brzycki_ << " kg |\n";
   }
 
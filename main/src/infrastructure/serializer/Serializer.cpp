@@ -2,81 +2,129 @@
 
 #include "infrastructure/serializer/serializer.hpp"
 
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <optional>
 
 #include "common/c_json_helper.hpp"
+#include "domain/services/date_service.hpp"
+#include "domain/services/volume_service.hpp"
 
-auto Serializer::CreateSetJson(const SetData& set_data) -> cJSON* {
+auto Serializer::CreateSetJson(int set_number, const SetData& set_data,
+                               const DailyData& day) -> cJSON* {
   cJSON* j_set = cJSON_CreateObject();
-  cJSON_AddNumberToObject(j_set, "set", set_data.set_number_);
-  if (!set_data.note_.empty()) {
-    cJSON_AddStringToObject(j_set, "note", set_data.note_.c_str());
+  cJSON_AddNumberToObject(j_set, "set", set_number);
+  if (set_data.note_index_ < day.set_notes_.size()) {
+    cJSON_AddStringToObject(j_set, "note",
+                            day.set_notes_[set_data.note_index_].c_str());
   }
 
-  if (set_data.weight_ < 0) {
-    cJSON_AddNumberToObject(j_set, "elastic_band", std::abs(set_data.weight_));
+  if (set_data.weight_g_ < 0) {
+    cJSON_AddNumberToObject(j_set, "elastic_band",
+                            Weight::ToLbs(-static_cast<Weight::GramReps>(
+                                set_data.weight_g_)));
     cJSON_AddStringToObject(j_set, "unit", "lbs");
     cJSON_AddNumberToObject(j_set, "reps", set_data.reps_);
     cJSON_AddNumberToObject(j_set, "volume", 0.0);
   } else {
-    cJSON_AddNumberToObject(j_set, "weight", set_data.weight_);
+    cJSON_AddNumberToObject(j_set, "weight", Weight::ToKg(set_data.weight_g_));
     cJSON_AddStringToObject(j_set, "unit", "kg");
     cJSON_AddNumberToObject(j_set, "reps", set_data.reps_);
-    cJSON_AddNumberToObject(j_set, "volume", set_data.volume_);
+    cJSON_AddNumberToObject(j_set, "volume", Weight::ToKg(set_data.Volume()));
   }
   return j_set;
 }
 
-auto Serializer::Serialize(const std::vector<DailyData>& processed_data)
-    -> std::string {
+auto Serializer::Serialize(const WorkoutLog& log) -> std::string {
+  const std::vector<DailyData>& processed_data = log.Days();
+  const SymbolTable& symbols = log.Symbols();
   if (processed_data.empty()) {
     return "{}";
   }
 
   CJsonPtr root = MakeCJson(cJSON_CreateObject());
 
-  const std::string& start_date = processed_data[0].date_;
-  cJSON_AddStringToObject(root.get(), "cycle_id", start_date.c_str());
+  const std::string kStartDate =
+      DateService::Format(processed_data[0].date_);
+  cJSON_AddStringToObject(root.get(), "cycle_id", kStartDate.c_str());
   cJSON_AddStringToObject(root.get(), "type", "mixed");
   cJSON_AddNumberToObject(root.get(), "total_days",
                           static_cast<double>(processed_data.size()));
 
   cJSON* j_sessions = cJSON_AddArrayToObject(root.get(), "sessions");
-
   for (const auto& daily : processed_data) {
-    cJSON* j_daily = cJSON_CreateObject();
-    cJSON_AddStringToObject(j_daily, "date", daily.date_.c_str());
-    if (!daily.note_.empty()) {
-      cJSON_AddStringToObject(j_daily, "note", daily.note_.c_str());
-    }
+    cJSON_AddItemToArray(j_sessions, CreateDayJson(daily, symbols));
+  }
 
-    cJSON* j_exercises = cJSON_AddArrayToObject(j_daily, "exercises");
+  char* json_string = cJSON_Print(root.get());
+  std::string result(json_string);
+  cJSON_free(json_string);
 
-    for (const auto& proj : daily.projects_) {
-      cJSON* j_proj = cJSON_CreateObject();
-      cJSON_AddStringToObject(j_proj, "name", proj.project_name_.c_str());
-      cJSON_AddStringToObject(j_proj, "type", proj.type_.c_str());
-      if (!proj.note_.empty()) {
-        cJSON_AddStringToObject(j_proj, "note", proj.note_.c_str());
-      }
-      cJSON_AddNumberToObject(j_proj, "totalVolume", proj.total_volume_);
+  return result;
+}
 
-      cJSON* j_sets = cJSON_AddArrayToObject(j_proj, "sets");
-      for (const auto& set_item : proj.sets_) {
-        cJSON_AddItemToArray(j_sets, CreateSetJson(set_item));
-      }
+auto Serializer::CreateDayJson(const DailyData& daily,
+                               const SymbolTable& symbols) -> cJSON* {
+  cJSON* j_daily = cJSON_CreateObject();
+  cJSON_AddStringToObject(j_daily, "date",
+                          DateService::Format(daily.date_).c_str());
+  if (!daily.note_.empty()) {
+    cJSON_AddStringToObject(j_daily, "note", daily.note_.c_str());
+  }
 
-      cJSON_AddItemToArray(j_exercises, j_proj);
+  cJSON* j_exercises = cJSON_AddArrayToObject(j_daily, "exercises");
+
+  for (const auto& proj : daily.projects_) {
+    cJSON* j_proj = cJSON_CreateObject();
+    cJSON_AddStringToObject(j_proj, "name",
+                            symbols.Resolve(proj.project_name_id_).data());
+    // The name as written in the log, so that the database can map it again
+    // when the mapping changes (see the remap command).
+    if (proj.short_name_id_ != SymbolTable::kEmpty) {
+      cJSON_AddStringToObject(j_proj, "code",
+                              symbols.Resolve(proj.short_name_id_).data());
+    }
+    cJSON_AddStringToObject(j_proj, "type",
+                            symbols.Resolve(proj.type_id_).data());
+    if (!proj.note_.empty()) {
+      cJSON_AddStringToObject(j_proj, "note", proj.note_.c_str());
     }
-    cJSON_AddItemToArray(j_sessions, j_daily);
+    cJSON_AddNumberToObject(j_proj, "totalVolume",
+                            Weight::ToKg(proj.total_volume_g_));
+
+    cJSON* j_sets = cJSON_AddArrayToObject(j_proj, "sets");
+    proj.ForEachSet([&](int set_number, const SetData& set_item) -> void {
+      cJSON_AddItemToArray(j_sets, CreateSetJson(set_number, set_item, daily));
+    });
+
+    cJSON_AddItemToArray(j_exercises, j_proj);
   }
+  return j_daily;
+}
 
-  char* json_string = cJSON_Print(root.get());
-  std::string result(json_string);
+StreamingSerializer::StreamingSerializer(std::ostream& out) : out_(out) {}
+
+auto StreamingSerializer::WriteDay(const DailyData& daily,
+                                   const SymbolTable& symbols) -> void {
+  if (day_count_ == 0) {
+    out_ << R"({"cycle_id":")" << DateService::Format(daily.date_)
+         << R"(","type":"mixed","sessions":[)";
+  }
+  CJsonPtr j_daily = MakeCJson(Serializer::CreateDayJson(daily, symbols));
+  char* json_string = cJSON_PrintUnformatted(j_daily.get());
+  out_ << (day_count_ == 0 ? "\n" : ",\n") << json_string;
   cJSON_free(json_string);
+  ++day_count_;
+}
 
-  return result;
+auto StreamingSerializer::Finish() -> void {
+  if (day_count_ == 0) {
+    out_ << "{}\n";
+    return;
+  }
+  out_ << "\n],\"total_days\":" << day_count_ << "}\n";
 }
 
 static auto GetString(const cJSON* item, const char* key,
@@ -106,27 +154,26 @@ static auto GetInt(const cJSON* item, const char* key, int default_val = 0)
   return default_val;
 }
 
-auto Serializer::ParseSetJson(const cJSON* json_set) -> SetData {
-  SetData set_data;
-  set_data.set_number_ = GetInt(json_set, "set");
-  set_data.reps_ = GetInt(json_set, "reps");
-  set_data.volume_ = GetDouble(json_set, "volume");
-  set_data.note_ = GetString(json_set, "note");
+auto Serializer::ParseSetJson(const cJSON* json_set, DailyData& day,
+                              ProjectData& project) -> void {
+  const int kReps = GetInt(json_set, "reps");
+  const std::uint16_t kNoteIndex = day.AddSetNote(GetString(json_set, "note"));
 
   double weight = GetDouble(json_set, "weight", 0.0);
   double elastic = GetDouble(json_set, "elastic_band", 0.0);
 
+  // Same convention as the log: loads are kg, elastic bands are lbs
+  Weight::Grams weight_g = 0;
   if (elastic > 0) {
-    set_data.weight_ = -elastic;
+    weight_g = -Weight::FromLbs(elastic).value_or(0);
   } else {
-    set_data.weight_ = weight;
+    weight_g = Weight::FromKg(weight).value_or(0);
   }
-
-  return set_data;
+  project.AddSet(weight_g, kReps, kNoteIndex);
 }
 
-auto Serializer::Deserialize(const cJSON* root) -> std::vector<DailyData> {
-  std::vector<DailyData> all_data;
+auto Serializer::Deserialize(const cJSON* root) -> WorkoutLog {
+  WorkoutLog all_data;
   if (root == nullptr || cJSON_IsObject(root) == 0) {
     return all_data;
   }
@@ -135,29 +182,48 @@ auto Serializer::Deserialize(const cJSON* root) -> std::vector<DailyData> {
   cJSON* session = nullptr;
 
   cJSON_ArrayForEach(session, sessions) {
-    DailyData daily;
-    daily.date_ = GetString(session, "date");
+    const std::string kDateText = GetString(session, "date");
+    const std::optional<std::chrono::sys_days> kDate =
+        DateService::Parse(kDateText);
+    if (!kDate.has_value()) {
+      std::cerr << "Warning: [Serializer] Skipping session with invalid date '"
+                << kDateText << "'." << std::endl;
+      continue;
+    }
+
+    DailyData& daily = all_data.AddDay();
+    const std::chrono::year_month_day kYmd{*kDate};
+    daily.month_day_ = kYmd.month() / kYmd.day();
+    daily.date_ = *kDate;
     daily.note_ = GetString(session, "note");
 
     cJSON* exercises = cJSON_GetObjectItemCaseSensitive(session, "exercises");
     cJSON* exercise = nullptr;
 
+    daily.projects_.reserve(
+        static_cast<size_t>(cJSON_GetArraySize(exercises)));
     cJSON_ArrayForEach(exercise, exercises) {
-      ProjectData proj;
-      proj.project_name_ = GetString(exercise, "name");
-      proj.type_ = GetString(exercise, "type");
+      // Built in place: the containers propagate the arena allocator, and
+      // nothing is copied into its parent afterwards.
+      ProjectData& proj = daily.projects_.emplace_back();
+      proj.project_name_id_ =
+          all_data.Symbols().Intern(GetString(exercise, "name"));
+      // Absent in files written before codes were recorded.
+      proj.short_name_id_ =
+          all_data.Symbols().Intern(GetString(exercise, "code"));
+      proj.type_id_ = all_data.Symbols().Intern(GetString(exercise, "type"));
       proj.note_ = GetString(exercise, "note");
-      proj.total_volume_ = GetDouble(exercise, "totalVolume");
 
       cJSON* sets = cJSON_GetObjectItemCaseSensitive(exercise, "sets");
       cJSON* set_item = nullptr;
 
       cJSON_ArrayForEach(set_item, sets) {
-        proj.sets_.push_back(ParseSetJson(set_item));
+        ParseSetJson(set_item, daily, proj);
       }
-      daily.projects_.push_back(proj);
     }
-    all_data.push_back(daily);
+    // Totals are recomputed from the sets in exact gram-reps instead of being
+    // read back from the rounded "totalVolume".
+    VolumeService::CalculateDailyVolume(daily);
   }
 
   return all_data;
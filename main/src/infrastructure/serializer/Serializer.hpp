@@ -4,18 +4,51 @@
 #define SERIALIZER_SERIALIZER_HPP_
 
 #include "domain/models/workout_item.hpp"
+#include "domain/models/workout_log.hpp"
 #include <cjson/cJSON.h>
+#include <cstddef>
+#include <ostream>
 #include <string>
 #include <vector>
 
 class Serializer {
 public:
-  [[nodiscard]] static auto Serialize(const std::vector<DailyData>& data) -> std::string;
-  [[nodiscard]] static auto Deserialize(const cJSON* root) -> std::vector<DailyData>;
+  [[nodiscard]] static auto Serialize(const WorkoutLog& log) -> std::string;
+  [[nodiscard]] static auto Deserialize(const cJSON* root) -> WorkoutLog;
+
+  // One session object, as it appears in Serialize()'s "sessions" array.
+  [[nodiscard]] static auto CreateDayJson(const DailyData& daily,
+                                          const SymbolTable& symbols) -> cJSON*;
+
+private:
+  // One JSON object per set: runs are expanded so the output lists every set
+  // with its own number, and the note is looked up in the day's note table.
+  [[nodiscard]] static auto CreateSetJson(int set_number,
+                                          const SetData& set_data,
+                                          const DailyData& day) -> cJSON*;
+  // Adds the set to `project`, merging it into the previous run when equal.
+  // "set" and "volume" are not read back: both follow from the set's position
+  // and its weight and reps. Weights are converted back to integer grams.
+  static auto ParseSetJson(const cJSON* json_set, DailyData& day,
+                           ProjectData& project) -> void;
+};
+
+// Writes the document Serialize() builds one day at a time, for output that
+// has to start before the whole log is parsed. The fields are the same, but
+// "total_days" comes last, once it is known, and each session takes one line.
+class StreamingSerializer {
+public:
+  explicit StreamingSerializer(std::ostream& out);
+
+  auto WriteDay(const DailyData& daily, const SymbolTable& symbols) -> void;
+
+  // Closes the document. Until then the output is incomplete JSON, so a
+  // reader cannot mistake an aborted conversion for a finished one.
+  auto Finish() -> void;
 
 private:
-  [[nodiscard]] static auto CreateSetJson(const SetData& set_data) -> cJSON*;
-  [[nodiscard]] static auto ParseSetJson(const cJSON* json_set) -> SetData;
+  std::ostream& out_;
+  std::size_t day_count_ = 0;
 };
 
 #endif // SERIALIZER_SERIALIZER_HPP_
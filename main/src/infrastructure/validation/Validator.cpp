@@ -2,30 +2,15 @@
 #include "infrastructure/validation/validator.hpp"
 
 #include <iostream>
-#include <sstream>
+#include <utility>
 
-#include "internal/line_validator.hpp"
-
-Validator::Validator(IMappingProvider& mapping_provider)
-    : mapping_provider_(mapping_provider) {}
 
 auto Validator::Validate(std::istream& input,
-                         const std::string& mapping_file_path) -> bool {
-  auto valid_titles_opt = LoadValidTitles(mapping_file_path);
-  if (!valid_titles_opt.has_value()) {
-    return false;
-  }
-
-  auto rules_opt = CreateRules(valid_titles_opt.value());
-  if (!rules_opt.has_value()) {
-    return false;
-  }
-  const auto& rules = rules_opt.value();
+                         std::shared_ptr<const ValidationRules> rules,
+                         ValidationOptions options) -> ValidationReport {
+  ValidationPass pass(std::move(rules), options);
 
-  LineValidator line_validator;
-  int error_count = 0;
   std::string line;
-
   while (std::getline(input, line)) {
     line.erase(0, line.find_first_not_of(" \t\n\r"));
     line.erase(line.find_last_not_of(" \t\n\r") + 1);
@@ -34,66 +19,90 @@ auto Validator::Validate(std::istream& input,
       continue;
     }
 
-    line_validator.ValidateLine(line, rules, error_count);
+    pass.Check(line);
+    if (pass.StoppedEarly()) {
+      break;
+    }
   }
 
-  line_validator.FinalizeValidation(error_count);
-
-  return error_count == 0;
+  pass.Finish();
+  return pass.Report();
 }
 
-auto Validator::CreateRules(const std::vector<std::string>& valid_titles)
-    -> std::optional<ValidationRules> {
-  if (valid_titles.empty()) {
-    std::cerr << "Warning: [Validator] No valid titles found in mapping file."
+auto Validator::LoadRules(const cJSON* mapping_root)
+    -> std::shared_ptr<const ValidationRules> {
+  if (cJSON_IsObject(mapping_root) == 0) {
+    std::cerr << "Error: [Validator] Mapping file content is not a JSON object."
               << std::endl;
+    return nullptr;
   }
-  std::stringstream title_regex_pattern;
-  title_regex_pattern << "^(";
-  for (size_t i = 0; i < valid_titles.size(); ++i) {
-    title_regex_pattern << valid_titles[i]
-                        << (i < valid_titles.size() - 1 ? "|" : "");
+  return BuildRules(LoadValidTitles(mapping_root));
+}
+
+auto Validator::BuildRules(std::vector<std::string> valid_titles)
+    -> std::shared_ptr<const ValidationRules> {
+  return std::make_shared<const ValidationRules>(
+      CreateRules(std::move(valid_titles)));
+}
+
+ValidationPass::ValidationPass(std::shared_ptr<const ValidationRules> rules,
+                               ValidationOptions options)
+    : rules_(std::move(rules)), options_(options) {}
+
+auto ValidationPass::Check(std::string_view line) -> bool {
+  if (!report_.stopped_early_) {
+    line_validator_.ValidateLine(line, *rules_, report_.diagnostics_,
+                                 options_.max_errors_);
+    ApplyLimit();
   }
-  title_regex_pattern << ")$";
-  std::string title_with_comment = title_regex_pattern.str();
-  if (!title_with_comment.empty() && title_with_comment.back() == '$') {
-    title_with_comment.pop_back();
-    title_with_comment += R"((\s*(?://|#|;).*)?$)";
+  return report_.Passed();
+}
+
+auto ValidationPass::Finish() -> bool {
+  // The end-of-file checks only make sense if the whole input was read.
+  if (!report_.stopped_early_) {
+    line_validator_.FinalizeValidation(report_.diagnostics_);
+    ApplyLimit();
   }
-  try {
-    return ValidationRules{
-        .year_regex = std::regex(R"(^y\d{4}$)"),
-        .date_regex = std::regex(R"(^\d{4}$)"),
-        .note_regex = std::regex(R"(^r\s+.+$)"),
-        .title_regex = std::regex(title_with_comment),
-        .content_regex = std::regex(
-            R"(^[+-]\s*\d+(\.\d+)?(lbs|kg|LBS|KG)?\s+\d+(\s*\+\s*\d+)*(\s*(?://|#|;).*)?$)")};
-  } catch (const std::regex_error& e) {
-    std::cerr << "Error: [Validator] Failed to create regex rules: " << e.what()
-              << std::endl;
-    return std::nullopt;
+  if (options_.text_output_ != nullptr && !report_.Passed()) {
+    *options_.text_output_ << FormatDiagnostics(report_) << std::flush;
   }
+  return report_.Passed();
 }
 
-auto Validator::LoadValidTitles(const std::string& mapping_file_path)
-    -> std::optional<std::vector<std::string>> {
-  auto json_data_opt = mapping_provider_.GetMappingData(mapping_file_path);
-  if (!json_data_opt.has_value()) {
-    std::cerr << "Error: [Validator] Could not read or parse mapping file at: "
-              << mapping_file_path << std::endl;
-    return std::nullopt;
-  }
+auto ValidationPass::Resume(int line_count, std::optional<int> year)
+    -> void {
+  line_validator_.Resume(line_count, year);
+}
+
+auto ValidationPass::Passed() const -> bool {
+  return report_.Passed();
+}
 
-  cJSON* root = json_data_opt.value().get();
+auto ValidationPass::ApplyLimit() -> void {
+  const std::size_t kLimit = options_.max_errors_;
+  if (kLimit != 0 && report_.diagnostics_.size() >= kLimit) {
+    report_.diagnostics_.resize(kLimit);
+    report_.stopped_early_ = true;
+  }
+}
 
-  if (cJSON_IsObject(root) == 0) {
-    std::cerr << "Error: [Validator] Mapping file content is not a JSON object."
+auto Validator::CreateRules(std::vector<std::string> valid_titles)
+    -> ValidationRules {
+  if (valid_titles.empty()) {
+    std::cerr << "Warning: [Validator] No valid titles found in mapping file."
               << std::endl;
-    return std::nullopt;
   }
+  TitleSuggester title_suggester(valid_titles);
+  return ValidationRules{
+      .title_matcher = TitleMatcher(std::move(valid_titles)),
+      .title_suggester = std::move(title_suggester)};
+}
 
+auto Validator::LoadValidTitles(const cJSON* mapping_root)
+    -> std::vector<std::string> {
   std::vector<std::string> titles;
-  cJSON* child = root->child;
+  const cJSON* child = mapping_root->child;
   while (child != nullptr) {
     if (child->string != nullptr) {
       titles.emplace_back(child->string);
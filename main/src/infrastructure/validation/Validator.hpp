@@ -2,35 +2,91 @@
 #ifndef VALIDATOR_VALIDATOR_HPP_
 #define VALIDATOR_VALIDATOR_HPP_
 
-#include "application/interfaces/i_mapping_provider.hpp"
+#include "application/interfaces/i_line_check.hpp"
+#include "infrastructure/validation/diagnostic.hpp"
+#include "infrastructure/validation/internal/line_validator.hpp"
+#include "infrastructure/validation/internal/title_matcher.hpp"
+#include "infrastructure/validation/internal/title_suggester.hpp"
+#include <cjson/cJSON.h>
 #include <iostream>
+#include <cstddef>
+#include <memory>
 #include <optional>
-#include <regex>
 #include <string>
+#include <string_view>
 #include <vector>
 
+// The year, date, note and content formats are fixed (see line_grammar.hpp);
+// only the titles come from the mapping. The suggester is built alongside
+// the matcher, so an unknown title costs a tree lookup, not a scan of the
+// mapping.
 struct ValidationRules {
-  std::regex year_regex;
-  std::regex date_regex;
-  std::regex note_regex;
-  std::regex title_regex;
-  std::regex content_regex;
+  TitleMatcher title_matcher;
+  TitleSuggester title_suggester;
 };
 
-class Validator {
+struct ValidationOptions {
+  // The pass records at most this many errors and then ignores the rest of
+  // the input; 0 means no limit.
+  std::size_t max_errors_ = 0;
+  // Finish() writes the errors here as text, in one piece. With nullptr the
+  // caller renders Report() itself.
+  std::ostream* text_output_ = &std::cerr;
+};
+
+// One validation run that is fed line by line, e.g. by the parser during a
+// fused validate+parse pass. Errors are collected, not printed as they are
+// found. The rules are immutable and may be shared by passes running on
+// different threads.
+class ValidationPass : public ILineCheck {
 public:
-  explicit Validator(IMappingProvider& mapping_provider);
+  explicit ValidationPass(std::shared_ptr<const ValidationRules> rules,
+                          ValidationOptions options = {});
 
-  [[nodiscard]] auto Validate(std::istream& input, const std::string& mapping_file_path) -> bool;
+  auto Check(std::string_view line) -> bool override;
+  auto Finish() -> bool override;
+  auto Resume(int line_count, std::optional<int> year) -> void override;
+  [[nodiscard]] auto Passed() const -> bool override;
+
+  // True once the error limit is reached; further lines are not checked.
+  [[nodiscard]] auto StoppedEarly() const -> bool {
+    return report_.stopped_early_;
+  }
+  [[nodiscard]] auto Report() const -> const ValidationReport& {
+    return report_;
+  }
 
 private:
-  IMappingProvider& mapping_provider_;
+  auto ApplyLimit() -> void;
+
+  std::shared_ptr<const ValidationRules> rules_;
+  ValidationOptions options_;
+  LineValidator line_validator_;
+  ValidationReport report_;
+};
 
-  [[nodiscard]] auto LoadValidTitles(const std::string& mapping_file_path)
-      -> std::optional<std::vector<std::string>>;
+class Validator {
+public:
+  // Validate-only mode: reads `input` to the end, or until the error limit
+  // is reached.
+  [[nodiscard]] static auto Validate(
+      std::istream& input, std::shared_ptr<const ValidationRules> rules,
+      ValidationOptions options = {}) -> ValidationReport;
+
+  // Builds the rules for a parsed mapping once, so that many passes can
+  // share them; nullptr if the mapping is not a JSON object.
+  [[nodiscard]] static auto LoadRules(const cJSON* mapping_root)
+      -> std::shared_ptr<const ValidationRules>;
+  // The same from a list of titles, e.g. those of the built-in mapping.
+  [[nodiscard]] static auto BuildRules(std::vector<std::string> valid_titles)
+      -> std::shared_ptr<const ValidationRules>;
+
+private:
+  [[nodiscard]] static auto LoadValidTitles(const cJSON* mapping_root)
+      -> std::vector<std::string>;
 
-  [[nodiscard]] static auto CreateRules(const std::vector<std::string>& valid_titles)
-      -> std::optional<ValidationRules>;
+  [[nodiscard]] static auto CreateRules(std::vector<std::string> valid_titles)
+      -> ValidationRules;
 };
 
 #endif // VALIDATOR_VALIDATOR_HPP_
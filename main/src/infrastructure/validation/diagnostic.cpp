@@ -0,0 +1,63 @@
+// validator/diagnostic.cpp
+
+#include "infrastructure/validation/diagnostic.hpp"
+
+auto DiagnosticKindName(DiagnosticKind kind) -> std::string_view {
+  switch (kind) {
+    case DiagnosticKind::kMissingYear:
+      return "missing_year";
+    case DiagnosticKind::kEmptyDate:
+      return "empty_date";
+    case DiagnosticKind::kUnexpectedDate:
+      return "unexpected_date";
+    case DiagnosticKind::kInvalidDate:
+      return "invalid_date";
+    case DiagnosticKind::kUnexpectedNote:
+      return "unexpected_note";
+    case DiagnosticKind::kDuplicateNote:
+      return "duplicate_note";
+    case DiagnosticKind::kUnexpectedContent:
+      return "unexpected_content";
+    case DiagnosticKind::kMalformedContent:
+      return "malformed_content";
+    case DiagnosticKind::kUnexpectedTitle:
+      return "unexpected_title";
+    case DiagnosticKind::kMissingContent:
+      return "missing_content";
+    case DiagnosticKind::kUnrecognizedLine:
+      return "unrecognized_line";
+  }
+  return "unknown";
+}
+
+auto FormatDiagnostics(const ValidationReport& report) -> std::string {
+  constexpr std::string_view kPrefix = "Error: [Validator] ";
+  std::string text;
+  for (const Diagnostic& diagnostic : report.diagnostics_) {
+    text.append(kPrefix).append(diagnostic.message_).push_back('\n');
+  }
+  return text;
+}
+
+auto AddValidationReportToJson(cJSON* object, const ValidationReport& report)
+    -> void {
+  cJSON_AddBoolToObject(object, "stopped_early",
+                        report.stopped_early_ ? 1 : 0);
+  cJSON* errors = cJSON_AddArrayToObject(object, "errors");
+  for (const Diagnostic& diagnostic : report.diagnostics_) {
+    cJSON* error = cJSON_CreateObject();
+    cJSON_AddNumberToObject(error, "line", diagnostic.line_);
+    cJSON_AddNumberToObject(error, "column", diagnostic.column_);
+    const std::string kKind(DiagnosticKindName(diagnostic.kind_));
+    cJSON_AddStringToObject(error, "kind", kKind.c_str());
+    cJSON_AddStringToObject(error, "message", diagnostic.message_.c_str());
+    if (!diagnostic.suggestions_.empty()) {
+      cJSON* suggestions = cJSON_AddArrayToObject(error, "suggestions");
+      for (const std::string& suggestion : diagnostic.suggestions_) {
+        cJSON_AddItemToArray(suggestions,
+                             cJSON_CreateString(suggestion.c_str()));
+      }
+    }
+    cJSON_AddItemToArray(errors, error);
+  }
+}
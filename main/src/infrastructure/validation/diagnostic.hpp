@@ -0,0 +1,63 @@
+// validator/diagnostic.hpp
+
+#ifndef VALIDATOR_DIAGNOSTIC_HPP_
+#define VALIDATOR_DIAGNOSTIC_HPP_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cjson/cJSON.h>
+
+enum class DiagnosticKind : std::uint8_t {
+  kMissingYear,        // the file does not start with y2025
+  kEmptyDate,          // a date line without any content line
+  kUnexpectedDate,     // a date line right after a title
+  kInvalidDate,        // a date line whose month and day do not exist
+  kUnexpectedNote,     // a note that does not follow a date line
+  kDuplicateNote,      // a second note for one date
+  kUnexpectedContent,  // a content line that does not follow a title
+  kMalformedContent,   // a line starting with + or - that is no content line
+  kUnexpectedTitle,    // a title before any date, or right after a title
+  kMissingContent,     // the file ends right after a title
+  kUnrecognizedLine    // none of the above, e.g. a title not in the mapping
+};
+
+// One validation error. Lines are counted over the non-blank lines of the
+// file, starting at 1; line 0 stands for the file as a whole. The column is
+// the 1-based byte position of the error in the line without its leading
+// whitespace, or 0 if the error concerns the whole line.
+struct Diagnostic {
+  int line_ = 0;
+  int column_ = 0;
+  DiagnosticKind kind_ = DiagnosticKind::kUnrecognizedLine;
+  std::string message_;
+  // Mapping keys close to an unrecognized title, closest first; the message
+  // names them as well.
+  std::vector<std::string> suggestions_;
+};
+
+// What one validation pass found.
+struct ValidationReport {
+  std::vector<Diagnostic> diagnostics_;
+  // The error limit was reached, so the rest of the input was not checked.
+  bool stopped_early_ = false;
+
+  [[nodiscard]] auto Passed() const -> bool { return diagnostics_.empty(); }
+};
+
+// "missing_year", "malformed_content", ...
+[[nodiscard]] auto DiagnosticKindName(DiagnosticKind kind) -> std::string_view;
+
+// The errors as the validator has always printed them, one
+// "Error: [Validator] ..." line each.
+[[nodiscard]] auto FormatDiagnostics(const ValidationReport& report)
+    -> std::string;
+
+// Adds "stopped_early" and "errors":[{"line", "column", "kind", "message"},
+// ...] to a JSON object. Errors with suggestions also get "suggestions".
+auto AddValidationReportToJson(cJSON* object, const ValidationReport& report)
+    -> void;
+
+#endif // VALIDATOR_DIAGNOSTIC_HPP_
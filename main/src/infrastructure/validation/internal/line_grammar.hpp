@@ -0,0 +1,302 @@
+// validator/internal/line_grammar.hpp
+
+#ifndef VALIDATOR_INTERNAL_LINE_GRAMMAR_HPP_
+#define VALIDATOR_INTERNAL_LINE_GRAMMAR_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// The fixed line formats of a log, each as a deterministic finite automaton.
+//
+// A grammar describes its automaton with a Step() function over states and
+// bytes; MatchesLine() turns that into a transition table at compile time and
+// walks a line through it once, without backtracking or allocation. The
+// grammars accept exactly what these ECMAScript regexes did, where \s is
+// " \t\n\v\f\r" and '.' is any byte but '\n' and '\r':
+//
+//   year     ^y\d{4}$
+//   date     ^\d{4}$
+//   note     ^r\s+.+$
+//   content  ^[+-]\s*\d+(\.\d+)?(lbs|kg|LBS|KG)?\s+\d+(\s*\+\s*\d+)*
+//            (\s*(?://|#|;).*)?$
+//
+// tests/line_grammar_test.cpp compares each grammar with its regex.
+namespace line_grammar {
+
+using State = std::uint8_t;
+
+[[nodiscard]] constexpr auto IsDigit(unsigned char byte) -> bool {
+  return byte >= '0' && byte <= '9';
+}
+
+[[nodiscard]] constexpr auto IsSpace(unsigned char byte) -> bool {
+  return byte == ' ' || byte == '\t' || byte == '\n' || byte == '\v' ||
+         byte == '\f' || byte == '\r';
+}
+
+[[nodiscard]] constexpr auto IsLineBreak(unsigned char byte) -> bool {
+  return byte == '\n' || byte == '\r';
+}
+
+// y2025
+struct YearLine {
+  static constexpr State kStates = 7;
+  static constexpr State kReject = 6;
+
+  // 0: start, 1: after 'y', 2..5: after that many digits.
+  [[nodiscard]] static constexpr auto Step(State state, unsigned char byte)
+      -> State {
+    if (state == 0) {
+      return byte == 'y' ? 1 : kReject;
+    }
+    return (state < 5 && IsDigit(byte)) ? static_cast<State>(state + 1)
+                                        : kReject;
+  }
+
+  [[nodiscard]] static constexpr auto Accepts(State state) -> bool {
+    return state == 5;
+  }
+};
+
+// 0105
+struct DateLine {
+  static constexpr State kStates = 6;
+  static constexpr State kReject = 5;
+
+  // The state is the number of digits read.
+  [[nodiscard]] static constexpr auto Step(State state, unsigned char byte)
+      -> State {
+    return (state < 4 && IsDigit(byte)) ? static_cast<State>(state + 1)
+                                        : kReject;
+  }
+
+  [[nodiscard]] static constexpr auto Accepts(State state) -> bool {
+    return state == 4;
+  }
+};
+
+// r <text>
+struct NoteLine {
+  enum : State {
+    kStart,
+    kR,            // "r"
+    kSpaceOnly,    // "r" and whitespace that cannot start the text
+    kSpaceOrText,  // the last blank may be the separator or start the text
+    kText,         // the separator is over
+    kReject,
+    kStates
+  };
+
+  // '\n' and '\r' are whitespace but never text, so they can only belong to
+  // the separator; any other blank after the first is ambiguous until a
+  // line break shows it was still separator.
+  [[nodiscard]] static constexpr auto Step(State state, unsigned char byte)
+      -> State {
+    switch (state) {
+      case kStart:
+        return byte == 'r' ? kR : kReject;
+      case kR:
+        return IsSpace(byte) ? kSpaceOnly : kReject;
+      case kSpaceOnly:
+      case kSpaceOrText:
+        if (IsLineBreak(byte)) {
+          return kSpaceOnly;
+        }
+        return IsSpace(byte) ? kSpaceOrText : kText;
+      case kText:
+        return IsLineBreak(byte) ? kReject : kText;
+      default:
+        return kReject;
+    }
+  }
+
+  [[nodiscard]] static constexpr auto Accepts(State state) -> bool {
+    return state == kSpaceOrText || state == kText;
+  }
+};
+
+// +60 10+8, -20.5kg 8 // note
+struct ContentLine {
+  enum : State {
+    kStart,
+    kSign,         // "+", optionally followed by whitespace
+    kWeight,       // "+60"
+    kPoint,        // "+60."
+    kFraction,     // "+60.5"
+    kUnitL,        // "+60l"
+    kUnitLb,       // "+60lb"
+    kUnitUpperL,   // "+60L"
+    kUnitUpperLb,  // "+60LB"
+    kUnitK,        // "+60k"
+    kUnitUpperK,   // "+60K"
+    kUnit,         // "+60kg"
+    kGap,          // "+60kg "
+    kReps,         // "+60kg 10", "+60kg 10+8"
+    kRepsSpace,    // "+60kg 10 "
+    kPlus,         // "+60kg 10 +"
+    kSlash,        // "+60kg 10 /"
+    kComment,      // "+60kg 10 // ..."
+    kReject,
+    kStates
+  };
+
+  [[nodiscard]] static constexpr auto Step(State state, unsigned char byte)
+      -> State {
+    switch (state) {
+      case kStart:
+        return (byte == '+' || byte == '-') ? kSign : kReject;
+      case kSign:
+        if (IsSpace(byte)) {
+          return kSign;
+        }
+        return IsDigit(byte) ? kWeight : kReject;
+      case kWeight:
+      case kFraction:
+        if (IsDigit(byte)) {
+          return state;
+        }
+        if (byte == '.' && state == kWeight) {
+          return kPoint;
+        }
+        return AfterNumber(byte);
+      case kPoint:
+        return IsDigit(byte) ? kFraction : kReject;
+      case kUnitL:
+        return byte == 'b' ? kUnitLb : kReject;
+      case kUnitLb:
+        return byte == 's' ? kUnit : kReject;
+      case kUnitUpperL:
+        return byte == 'B' ? kUnitUpperLb : kReject;
+      case kUnitUpperLb:
+        return byte == 'S' ? kUnit : kReject;
+      case kUnitK:
+        return byte == 'g' ? kUnit : kReject;
+      case kUnitUpperK:
+        return byte == 'G' ? kUnit : kReject;
+      case kUnit:
+        return IsSpace(byte) ? kGap : kReject;
+      case kGap:
+        if (IsSpace(byte)) {
+          return kGap;
+        }
+        return IsDigit(byte) ? kReps : kReject;
+      case kReps:
+        if (IsDigit(byte)) {
+          return kReps;
+        }
+        return AfterReps(byte);
+      case kRepsSpace:
+        return AfterReps(byte);
+      case kPlus:
+        if (IsSpace(byte)) {
+          return kPlus;
+        }
+        return IsDigit(byte) ? kReps : kReject;
+      case kSlash:
+        return byte == '/' ? kComment : kReject;
+      case kComment:
+        return IsLineBreak(byte) ? kReject : kComment;
+      default:
+        return kReject;
+    }
+  }
+
+  [[nodiscard]] static constexpr auto Accepts(State state) -> bool {
+    return state == kReps || state == kComment;
+  }
+
+private:
+  // The weight is followed by an optional unit and then whitespace.
+  [[nodiscard]] static constexpr auto AfterNumber(unsigned char byte)
+      -> State {
+    switch (byte) {
+      case 'l':
+        return kUnitL;
+      case 'L':
+        return kUnitUpperL;
+      case 'k':
+        return kUnitK;
+      case 'K':
+        return kUnitUpperK;
+      default:
+        return IsSpace(byte) ? kGap : kReject;
+    }
+  }
+
+  // A rep count is followed by whitespace, '+' and another count, or a
+  // comment.
+  [[nodiscard]] static constexpr auto AfterReps(unsigned char byte) -> State {
+    if (IsSpace(byte)) {
+      return kRepsSpace;
+    }
+    switch (byte) {
+      case '+':
+        return kPlus;
+      case '/':
+        return kSlash;
+      case '#':
+      case ';':
+        return kComment;
+      default:
+        return kReject;
+    }
+  }
+};
+
+template <typename Grammar>
+using TransitionTable = std::array<std::array<State, 256>,
+                                   static_cast<std::size_t>(Grammar::kStates)>;
+
+template <typename Grammar>
+[[nodiscard]] consteval auto BuildTable() -> TransitionTable<Grammar> {
+  TransitionTable<Grammar> table{};
+  for (std::size_t state = 0; state < table.size(); ++state) {
+    for (std::size_t byte = 0; byte < 256; ++byte) {
+      table[state][byte] = Grammar::Step(static_cast<State>(state),
+                                         static_cast<unsigned char>(byte));
+    }
+  }
+  return table;
+}
+
+template <typename Grammar>
+inline constexpr TransitionTable<Grammar> kTable = BuildTable<Grammar>();
+
+// Where `line` stops matching: the index of the first byte the automaton
+// rejects, line.size() if the line ends too early, or npos if it matches.
+template <typename Grammar>
+[[nodiscard]] constexpr auto MismatchPosition(std::string_view line)
+    -> std::size_t {
+  State state = 0;
+  for (std::size_t pos = 0; pos < line.size(); ++pos) {
+    state = kTable<Grammar>[state][static_cast<unsigned char>(line[pos])];
+    if (state == Grammar::kReject) {
+      return pos;
+    }
+  }
+  return Grammar::Accepts(state) ? std::string_view::npos : line.size();
+}
+
+template <typename Grammar>
+[[nodiscard]] constexpr auto MatchesLine(std::string_view line) -> bool {
+  return MismatchPosition<Grammar>(line) == std::string_view::npos;
+}
+
+static_assert(MatchesLine<YearLine>("y2025"));
+static_assert(!MatchesLine<YearLine>("y202"));
+static_assert(MatchesLine<DateLine>("0105"));
+static_assert(!MatchesLine<DateLine>("01050"));
+static_assert(MatchesLine<NoteLine>("r  x"));
+static_assert(MatchesLine<NoteLine>("r \r "));
+static_assert(!MatchesLine<NoteLine>("r x\r"));
+static_assert(MatchesLine<ContentLine>("+60.5kg 10 + 8 // easy"));
+static_assert(!MatchesLine<ContentLine>("+60Kg 10"));
+static_assert(!MatchesLine<ContentLine>("+60 10 "));
+static_assert(MismatchPosition<ContentLine>("+60Kg 10") == 4);
+static_assert(MismatchPosition<ContentLine>("+60") == 3);
+
+}  // namespace line_grammar
+
+#endif // VALIDATOR_INTERNAL_LINE_GRAMMAR_HPP_
@@ -2,78 +2,142 @@
 
 #include "infrastructure/validation/internal/line_validator.hpp"
 
-#include <iostream>
+#include <charconv>
+#include <chrono>
+#include <string>
+#include <utility>
 
+#include "infrastructure/validation/internal/line_grammar.hpp"
 #include "infrastructure/validation/validator.hpp"
 
+namespace {
+
+auto Report(std::vector<Diagnostic>& diagnostics, DiagnosticKind kind,
+            int line, std::string message, int column = 0,
+            std::vector<std::string> suggestions = {}) -> void {
+  diagnostics.push_back({.line_ = line,
+                         .column_ = column,
+                         .kind_ = kind,
+                         .message_ = std::move(message),
+                         .suggestions_ = std::move(suggestions)});
+}
+
+auto AtLine(int line) -> std::string {
+  return " at line " + std::to_string(line);
+}
+
+auto Quoted(std::string_view line) -> std::string {
+  std::string quoted;
+  quoted.reserve(line.size() + 2);
+  quoted.push_back('"');
+  quoted.append(line);
+  quoted.push_back('"');
+  return quoted;
+}
+
+// " Did you mean "bp"?", " Did you mean "bq", "sq" or "bp"?", or nothing.
+auto DidYouMean(const std::vector<std::string>& suggestions) -> std::string {
+  std::string text;
+  for (std::size_t i = 0; i < suggestions.size(); ++i) {
+    if (i == 0) {
+      text = ". Did you mean ";
+    } else {
+      text += i + 1 == suggestions.size() ? " or " : ", ";
+    }
+    text += Quoted(suggestions[i]);
+  }
+  return text.empty() ? text : text + "?";
+}
+
+}  // namespace
+
 LineValidator::LineValidator() = default;
 
-auto LineValidator::ValidateLine(const std::string& line,
-                                 const ValidationRules& rules, int& error_count)
-    -> void {
+auto LineValidator::ValidateLine(std::string_view line,
+                                 const ValidationRules& rules,
+                                 std::vector<Diagnostic>& diagnostics,
+                                 std::size_t max_diagnostics) -> void {
   state_.line_counter++;
 
-  if (HandleYearState(line, rules, error_count)) {
+  if (HandleYearState(line, diagnostics)) {
     return;
   }
-  if (HandleDateMatch(line, rules, error_count)) {
+  if (HandleDateMatch(line, diagnostics)) {
     return;
   }
-  if (HandleNoteMatch(line, rules, error_count)) {
+  if (HandleNoteMatch(line, diagnostics)) {
     return;
   }
-  if (HandleContentMatch(line, rules, error_count)) {
+  if (HandleContentMatch(line, diagnostics)) {
     return;
   }
-  if (HandleTitleMatch(line, rules, error_count)) {
+  if (HandleTitleMatch(line, rules, diagnostics)) {
     return;
   }
 
-  std::cerr << "Error: [Validator] Unrecognized format at line "
-            << state_.line_counter << ": \"" << line << "\"" << std::endl;
-  error_count++;
+  // Suggest() scores every mapping key; skip it for an error the limit
+  // drops.
+  const bool kEmitted =
+      max_diagnostics == 0 || diagnostics.size() < max_diagnostics;
+  std::vector<std::string> suggestions =
+      kEmitted ? rules.title_suggester.Suggest(line)
+               : std::vector<std::string>{};
+  std::string message = "Unrecognized format" + AtLine(state_.line_counter) +
+                        ": " + Quoted(line) + DidYouMean(suggestions);
+  Report(diagnostics, DiagnosticKind::kUnrecognizedLine, state_.line_counter,
+         std::move(message), 0, std::move(suggestions));
+}
+
+auto LineValidator::Resume(int line_count, std::optional<int> year)
+    -> void {
+  // A date line is accepted the same way after the year line and after a
+  // finished block, so the state right after the year stands in for both.
+  state_ = ValidationState{};
+  state_.current_state = StateType::EXPECTING_DATE;
+  state_.line_counter = line_count;
+  state_.year = year;
 }
 
-auto LineValidator::HandleYearState(const std::string& line,
-                                    const ValidationRules& rules,
-                                    int& error_count) -> bool {
+auto LineValidator::HandleYearState(std::string_view line,
+                                    std::vector<Diagnostic>& diagnostics)
+    -> bool {
   if (state_.current_state != StateType::EXPECTING_YEAR) {
     return false;
   }
 
-  if (std::regex_match(line, rules.year_regex)) {
+  if (line_grammar::MatchesLine<line_grammar::YearLine>(line)) {
+    int year = 0;
+    std::from_chars(line.data() + 1, line.data() + line.size(), year);
+    state_.year = year;
     state_.current_state = StateType::EXPECTING_DATE;
     return true;
   }
 
-  std::cerr << "Error: [Validator] Invalid format at line "
-            << state_.line_counter
-            << ". Expected a year declaration (e.g., y2025) at the "
-               "beginning of the file."
-            << std::endl;
-  error_count++;
+  Report(diagnostics, DiagnosticKind::kMissingYear, state_.line_counter,
+         "Invalid format" + AtLine(state_.line_counter) +
+             ". Expected a year declaration (e.g., y2025) at the beginning "
+             "of the file.");
   state_.current_state = StateType::EXPECTING_DATE;
   return true;
 }
 
-auto LineValidator::HandleDateMatch(const std::string& line,
-                                    const ValidationRules& rules,
-                                    int& error_count) -> bool {
-  if (!std::regex_match(line, rules.date_regex)) {
+auto LineValidator::HandleDateMatch(std::string_view line,
+                                    std::vector<Diagnostic>& diagnostics)
+    -> bool {
+  if (!line_grammar::MatchesLine<line_grammar::DateLine>(line)) {
     return false;
   }
 
   if (state_.last_date_line > 0 && !state_.content_seen_for_date) {
-    std::cerr << "Error: [Validator] The date entry at line "
-              << state_.last_date_line << " is empty." << std::endl;
-    error_count++;
+    Report(diagnostics, DiagnosticKind::kEmptyDate, state_.last_date_line,
+           "The date entry" + AtLine(state_.last_date_line) + " is empty.");
   }
   if (state_.current_state == StateType::EXPECTING_CONTENT) {
-    std::cerr << "Error: [Validator] Unexpected date at line "
-              << state_.line_counter << ". A content line was expected."
-              << std::endl;
-    error_count++;
+    Report(diagnostics, DiagnosticKind::kUnexpectedDate, state_.line_counter,
+           "Unexpected date" + AtLine(state_.line_counter) +
+               ". A content line was expected.");
   }
+  CheckDate(line, diagnostics);
   state_.last_date_line = state_.line_counter;
   state_.content_seen_for_date = false;
   state_.note_seen_for_date = false;
@@ -81,34 +145,55 @@ auto LineValidator::HandleDateMatch(const std::string& line,
   return true;
 }
 
-auto LineValidator::HandleNoteMatch(const std::string& line,
-                                    const ValidationRules& rules,
-                                    int& error_count) -> bool {
-  if (!std::regex_match(line, rules.note_regex)) {
+auto LineValidator::CheckDate(std::string_view line,
+                              std::vector<Diagnostic>& diagnostics) const
+    -> void {
+  // The same check the parser and the date completion apply to MMDD, so a
+  // file that passes validation does not fail on its dates when ingested.
+  auto two_digits = [&](std::size_t pos) -> unsigned {
+    return static_cast<unsigned>(((line[pos] - '0') * 10) +
+                                 (line[pos + 1] - '0'));
+  };
+  const std::chrono::month_day kMonthDay{std::chrono::month{two_digits(0)},
+                                         std::chrono::day{two_digits(2)}};
+  if (!kMonthDay.ok()) {
+    Report(diagnostics, DiagnosticKind::kInvalidDate, state_.line_counter,
+           "Invalid date" + AtLine(state_.line_counter) + ": " +
+               Quoted(line) + " is not a valid month and day.");
+  } else if (state_.year.has_value() &&
+             !(std::chrono::year{*state_.year} / kMonthDay).ok()) {
+    Report(diagnostics, DiagnosticKind::kInvalidDate, state_.line_counter,
+           "Invalid date" + AtLine(state_.line_counter) + ": " +
+               Quoted(line) + " does not exist in " +
+               std::to_string(*state_.year) + ".");
+  }
+}
+
+auto LineValidator::HandleNoteMatch(std::string_view line,
+                                    std::vector<Diagnostic>& diagnostics)
+    -> bool {
+  if (!line_grammar::MatchesLine<line_grammar::NoteLine>(line)) {
     return false;
   }
 
   if (state_.current_state != StateType::EXPECTING_TITLE) {
-    std::cerr << "Error: [Validator] Unexpected note at line "
-              << state_.line_counter
-              << ". Notes must appear immediately after a date line."
-              << std::endl;
-    error_count++;
+    Report(diagnostics, DiagnosticKind::kUnexpectedNote, state_.line_counter,
+           "Unexpected note" + AtLine(state_.line_counter) +
+               ". Notes must appear immediately after a date line.");
     return true;
   }
   if (state_.note_seen_for_date) {
-    std::cerr << "Error: [Validator] Duplicate note at line "
-              << state_.line_counter << "." << std::endl;
-    error_count++;
+    Report(diagnostics, DiagnosticKind::kDuplicateNote, state_.line_counter,
+           "Duplicate note" + AtLine(state_.line_counter) + ".");
     return true;
   }
   state_.note_seen_for_date = true;
   return true;
 }
 
-auto LineValidator::HandleContentMatch(const std::string& line,
-                                       const ValidationRules& rules,
-                                       int& error_count) -> bool {
+auto LineValidator::HandleContentMatch(std::string_view line,
+                                       std::vector<Diagnostic>& diagnostics)
+    -> bool {
   if (line[0] != '+' && line[0] != '-') {
     return false;
   }
@@ -116,67 +201,66 @@ auto LineValidator::HandleContentMatch(const std::string& line,
   if (state_.current_state == StateType::EXPECTING_YEAR ||
       state_.current_state == StateType::EXPECTING_DATE ||
       state_.current_state == StateType::EXPECTING_TITLE) {
-    std::cerr << "Error: [Validator] Invalid format at line "
-              << state_.line_counter << ". Unexpected content line."
-              << std::endl;
-    error_count++;
+    Report(diagnostics, DiagnosticKind::kUnexpectedContent,
+           state_.line_counter,
+           "Invalid format" + AtLine(state_.line_counter) +
+               ". Unexpected content line.");
     return true;
   }
-  if (!std::regex_match(line, rules.content_regex)) {
-    std::cerr << "Error: [Validator] Malformed content line at "
-              << state_.line_counter << ": \"" << line << "\"" << std::endl;
-    error_count++;
+  const std::size_t kMismatch =
+      line_grammar::MismatchPosition<line_grammar::ContentLine>(line);
+  if (kMismatch != std::string_view::npos) {
+    Report(diagnostics, DiagnosticKind::kMalformedContent, state_.line_counter,
+           "Malformed content line at " + std::to_string(state_.line_counter) +
+               ": " + Quoted(line),
+           static_cast<int>(kMismatch) + 1);
   }
   state_.content_seen_for_date = true;
   state_.current_state = StateType::EXPECTING_TITLE_OR_CONTENT;
   return true;
 }
 
-auto LineValidator::HandleTitleMatch(const std::string& line,
+auto LineValidator::HandleTitleMatch(std::string_view line,
                                      const ValidationRules& rules,
-                                     int& error_count) -> bool {
-  if (!std::regex_match(line, rules.title_regex)) {
+                                     std::vector<Diagnostic>& diagnostics)
+    -> bool {
+  if (!rules.title_matcher.Matches(line)) {
     return false;
   }
 
   if (state_.current_state == StateType::EXPECTING_YEAR ||
       state_.current_state == StateType::EXPECTING_DATE) {
-    std::cerr << "Error: [Validator] Invalid format at line "
-              << state_.line_counter << ". Expected a date but found a title."
-              << std::endl;
-    error_count++;
+    Report(diagnostics, DiagnosticKind::kUnexpectedTitle, state_.line_counter,
+           "Invalid format" + AtLine(state_.line_counter) +
+               ". Expected a date but found a title.");
   } else if (state_.current_state == StateType::EXPECTING_CONTENT) {
-    std::cerr << "Error: [Validator] Invalid format at line "
-              << state_.line_counter
-              << ". Expected a content line but found another title."
-              << std::endl;
-    error_count++;
+    Report(diagnostics, DiagnosticKind::kUnexpectedTitle, state_.line_counter,
+           "Invalid format" + AtLine(state_.line_counter) +
+               ". Expected a content line but found another title.");
   }
   state_.current_state = StateType::EXPECTING_CONTENT;
   return true;
 }
 
-auto LineValidator::FinalizeValidation(int& error_count) const -> void {
+auto LineValidator::FinalizeValidation(
+    std::vector<Diagnostic>& diagnostics) const -> void {
   if (state_.current_state == StateType::EXPECTING_YEAR) {
-    std::cerr << "Error: [Validator] File is empty or does not start with a "
-                 "year declaration (e.g., y2025)."
-              << std::endl;
-    error_count++;
+    Report(diagnostics, DiagnosticKind::kMissingYear, 0,
+           "File is empty or does not start with a year declaration (e.g., "
+           "y2025).");
     return;
   }
 
   if (state_.last_date_line > 0 && !state_.content_seen_for_date) {
-    std::cerr << "Error: [Validator] The last date entry at line "
-              << state_.last_date_line
-              << " is empty and must contain at least one record." << std::endl;
-    error_count++;
+    Report(diagnostics, DiagnosticKind::kEmptyDate, state_.last_date_line,
+           "The last date entry" + AtLine(state_.last_date_line) +
+               " is empty and must contain at least one record.");
     return;
   }
 
   if (state_.current_state == StateType::EXPECTING_CONTENT) {
-    std::cerr
-        << "Error: [Validator] File ends unexpectedly after a title on line "
-        << state_.line_counter << ". Missing content line." << std::endl;
-    error_count++;
+    Report(diagnostics, DiagnosticKind::kMissingContent, state_.line_counter,
+           "File ends unexpectedly after a title on line " +
+               std::to_string(state_.line_counter) + ". Missing content line.");
   }
 }
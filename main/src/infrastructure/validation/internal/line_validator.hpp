@@ -3,9 +3,13 @@
 #ifndef VALIDATOR_INTERNAL_LINE_VALIDATOR_HPP_
 #define VALIDATOR_INTERNAL_LINE_VALIDATOR_HPP_
 
+#include <cstddef>
 #include <optional>
-#include <regex>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include "infrastructure/validation/diagnostic.hpp"
 
 enum class StateType {
   EXPECTING_YEAR,
@@ -17,14 +21,23 @@ enum class StateType {
 
 struct ValidationRules;
 
+// Appends every error it finds to `diagnostics`, in line order.
 class LineValidator {
 public:
   LineValidator();
 
-  auto ValidateLine(const std::string& line, const ValidationRules& rules,
-                    int& error_count) -> void;
+  // `max_diagnostics` is the caller's error limit (0: none). Errors past it
+  // are dropped, so they are reported without title suggestions.
+  auto ValidateLine(std::string_view line, const ValidationRules& rules,
+                    std::vector<Diagnostic>& diagnostics,
+                    std::size_t max_diagnostics = 0) -> void;
+
+  auto FinalizeValidation(std::vector<Diagnostic>& diagnostics) const -> void;
 
-  auto FinalizeValidation(int& error_count) const -> void;
+  // Skips `line_count` lines that are known to be valid and to end with a
+  // complete date block (or with the year line); `year` is the year they
+  // declared
+  auto Resume(int line_count, std::optional<int> year) -> void;
 
 private:
   struct ValidationState {
@@ -33,18 +46,23 @@ private:
     bool content_seen_for_date = false;
     bool note_seen_for_date = false;
     int last_date_line = 0;
+    // From the year line; dates are checked against it
+    std::optional<int> year;
   };
 
-  auto HandleYearState(const std::string& line, const ValidationRules& rules,
-                      int& error_count) -> bool;
-  auto HandleDateMatch(const std::string& line, const ValidationRules& rules,
-                      int& error_count) -> bool;
-  auto HandleNoteMatch(const std::string& line, const ValidationRules& rules,
-                      int& error_count) -> bool;
-  auto HandleContentMatch(const std::string& line, const ValidationRules& rules,
-                         int& error_count) -> bool;
-  auto HandleTitleMatch(const std::string& line, const ValidationRules& rules,
-                       int& error_count) -> bool;
+  auto HandleYearState(std::string_view line,
+                       std::vector<Diagnostic>& diagnostics) -> bool;
+  auto HandleDateMatch(std::string_view line,
+                       std::vector<Diagnostic>& diagnostics) -> bool;
+  // Reports a date line whose month and day do not exist (in the year)
+  auto CheckDate(std::string_view line,
+                 std::vector<Diagnostic>& diagnostics) const -> void;
+  auto HandleNoteMatch(std::string_view line,
+                       std::vector<Diagnostic>& diagnostics) -> bool;
+  auto HandleContentMatch(std::string_view line,
+                          std::vector<Diagnostic>& diagnostics) -> bool;
+  auto HandleTitleMatch(std::string_view line, const ValidationRules& rules,
+                        std::vector<Diagnostic>& diagnostics) -> bool;
 
   ValidationState state_;
 };
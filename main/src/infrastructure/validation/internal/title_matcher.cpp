@@ -0,0 +1,110 @@
+// validator/internal/title_matcher.cpp
+
+#include "infrastructure/validation/internal/title_matcher.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+
+#include "infrastructure/validation/internal/line_grammar.hpp"
+
+TitleMatcher::TitleMatcher() : nodes_(1) {}
+
+TitleMatcher::TitleMatcher(std::vector<std::string> titles) : nodes_(1) {
+  std::ranges::sort(titles);
+  const auto [kFirstDuplicate, kLast] = std::ranges::unique(titles);
+  titles.erase(kFirstDuplicate, kLast);
+
+  // Built breadth first over the sorted keys. The keys below a node form a
+  // contiguous range that shares its prefix, with the key equal to the prefix
+  // (if any) first. The node's children are the distinct bytes at the next
+  // position; they are created together so that their edges are contiguous,
+  // and come out sorted because the keys are.
+  struct Pending {
+    std::uint32_t node_;
+    std::size_t begin_;
+    std::size_t end_;
+    std::size_t depth_;
+  };
+  std::deque<Pending> pending{{0, 0, titles.size(), 0}};
+  while (!pending.empty()) {
+    auto [node, begin, end, depth] = pending.front();
+    pending.pop_front();
+
+    if (begin < end && titles[begin].size() == depth) {
+      nodes_[node].terminal_ = true;
+      ++begin;
+    }
+    const auto kFirstEdge = static_cast<std::uint32_t>(edges_.size());
+    while (begin < end) {
+      const char kByte = titles[begin][depth];
+      std::size_t group_end = begin + 1;
+      while (group_end < end && titles[group_end][depth] == kByte) {
+        ++group_end;
+      }
+      const auto kChild = static_cast<std::uint32_t>(nodes_.size());
+      nodes_.emplace_back();
+      edges_.push_back({static_cast<unsigned char>(kByte), kChild});
+      pending.push_back({kChild, begin, group_end, depth + 1});
+      begin = group_end;
+    }
+    nodes_[node].first_edge_ = kFirstEdge;
+    nodes_[node].edge_count_ =
+        static_cast<std::uint32_t>(edges_.size()) - kFirstEdge;
+  }
+}
+
+auto TitleMatcher::Matches(std::string_view line) const -> bool {
+  std::uint32_t node = 0;
+  for (std::size_t i = 0;; ++i) {
+    // Keys may be prefixes of each other ("bp", "bpx"), so every key that
+    // ends along the way gets its chance.
+    if (nodes_[node].terminal_ && IsCommentSuffix(line.substr(i))) {
+      return true;
+    }
+    if (i == line.size()) {
+      return false;
+    }
+    node = Child(nodes_[node], static_cast<unsigned char>(line[i]));
+    if (node == kNoChild) {
+      return false;
+    }
+  }
+}
+
+auto TitleMatcher::Child(const Node& node, unsigned char byte) const
+    -> std::uint32_t {
+  const auto kBegin = edges_.begin() + node.first_edge_;
+  const auto kEnd = kBegin + node.edge_count_;
+  const auto kEdge =
+      std::lower_bound(kBegin, kEnd, byte,
+                       [](const Edge& edge, unsigned char value) -> bool {
+                         return edge.byte_ < value;
+                       });
+  return (kEdge != kEnd && kEdge->byte_ == byte) ? kEdge->target_ : kNoChild;
+}
+
+auto TitleMatcher::IsCommentSuffix(std::string_view rest) -> bool {
+  if (rest.empty()) {
+    return true;
+  }
+  const std::size_t kDelimiter = rest.find_first_not_of(" \t\n\v\f\r");
+  if (kDelimiter == std::string_view::npos) {
+    return false;
+  }
+  rest.remove_prefix(kDelimiter);
+  std::size_t delimiter_length = 0;
+  if (rest.starts_with("//")) {
+    delimiter_length = 2;
+  } else if (rest.starts_with('#') || rest.starts_with(';')) {
+    delimiter_length = 1;
+  } else {
+    return false;
+  }
+  // The comment is the regex's '.*', which stops at a line break.
+  return std::ranges::none_of(rest.substr(delimiter_length),
+                              [](char byte) -> bool {
+                                return line_grammar::IsLineBreak(
+                                    static_cast<unsigned char>(byte));
+                              });
+}
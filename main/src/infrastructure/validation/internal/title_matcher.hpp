@@ -0,0 +1,48 @@
+// validator/internal/title_matcher.hpp
+
+#ifndef VALIDATOR_INTERNAL_TITLE_MATCHER_HPP_
+#define VALIDATOR_INTERNAL_TITLE_MATCHER_HPP_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Recognizes title lines: one of the mapping keys, taken literally, either
+// alone or followed by a comment ("bp", "bp // easy", "bp#easy", "bp ; x").
+//
+// The keys are stored in a byte trie, so a line is matched in a single walk
+// over its characters no matter how many keys the mapping has. The trie is
+// immutable once built and may be shared between threads.
+class TitleMatcher {
+public:
+  TitleMatcher();
+  explicit TitleMatcher(std::vector<std::string> titles);
+
+  [[nodiscard]] auto Matches(std::string_view line) const -> bool;
+
+private:
+  struct Node {
+    std::uint32_t first_edge_ = 0;
+    std::uint32_t edge_count_ = 0;
+    bool terminal_ = false;  // a key ends here
+  };
+  // The edges of one node are contiguous and sorted by byte.
+  struct Edge {
+    unsigned char byte_ = 0;
+    std::uint32_t target_ = 0;
+  };
+
+  static constexpr std::uint32_t kNoChild = UINT32_MAX;
+
+  [[nodiscard]] auto Child(const Node& node, unsigned char byte) const
+      -> std::uint32_t;
+  // What may follow a complete key: nothing, or optional whitespace and a
+  // comment delimiter followed by anything but a line break.
+  [[nodiscard]] static auto IsCommentSuffix(std::string_view rest) -> bool;
+
+  std::vector<Node> nodes_;  // nodes_[0] is the root
+  std::vector<Edge> edges_;
+};
+
+#endif // VALIDATOR_INTERNAL_TITLE_MATCHER_HPP_
@@ -0,0 +1,215 @@
+// validator/internal/title_suggester.cpp
+
+#include "infrastructure/validation/internal/title_suggester.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+// Titles up to this many bytes get suggestions within one edit, longer ones
+// within two (the cut-off common in fuzzy search). Two edits away from a
+// two-letter code is any other two-letter code.
+constexpr std::size_t kShortTitle = 5;
+
+// The title a line names, without a trailing comment; see TitleMatcher.
+auto TitleOf(std::string_view line) -> std::string_view {
+  std::size_t end = 0;
+  while (end < line.size() && line[end] != '#' && line[end] != ';' &&
+         !line.substr(end).starts_with("//")) {
+    ++end;
+  }
+  line = line.substr(0, end);
+  const std::size_t kLast = line.find_last_not_of(" \t\n\v\f\r");
+  return kLast == std::string_view::npos ? std::string_view{}
+                                         : line.substr(0, kLast + 1);
+}
+
+// Unrestricted Damerau-Levenshtein distance (Lowrance-Wagner). Unlike the
+// common "optimal string alignment" variant, which forbids editing a
+// transposed pair again, it satisfies the triangle inequality that the
+// BK-tree depends on. The buffers are reused from call to call.
+class EditDistance {
+public:
+  static constexpr std::size_t kUnbounded = SIZE_MAX - 1;
+
+  // The distance, or limit + 1 as soon as it is known to exceed `limit`.
+  auto operator()(std::string_view from, std::string_view to,
+                  std::size_t limit = kUnbounded) -> std::size_t {
+    const std::size_t kDistance = Compute(from, to, limit);
+    // Only the entries of the bytes in `from` can have been set.
+    for (const char kByte : from) {
+      last_row_[static_cast<unsigned char>(kByte)] = 0;
+    }
+    return kDistance;
+  }
+
+private:
+  auto Compute(std::string_view from, std::string_view to, std::size_t limit)
+      -> std::size_t {
+    const std::size_t kRows = from.size();
+    const std::size_t kColumns = to.size();
+    if ((kRows > kColumns ? kRows - kColumns : kColumns - kRows) > limit) {
+      return limit + 1;
+    }
+    const std::size_t kWidth = kColumns + 2;
+    const std::size_t kInfinity = kRows + kColumns;
+    // cell(i + 1, j + 1) is the distance between the first i bytes of
+    // `from` and the first j bytes of `to`; row and column 0 are sentinels.
+    // A cell with |i - j| > limit is more than limit, which is all the
+    // caller needs to know; such cells, like the sentinels, stay kInfinity.
+    table_.assign((kRows + 2) * kWidth, kInfinity);
+    for (std::size_t row = 0; row <= kRows; ++row) {
+      table_[((row + 1) * kWidth) + 1] = row;
+    }
+    for (std::size_t column = 0; column <= kColumns; ++column) {
+      table_[kWidth + column + 1] = column;
+    }
+
+    for (std::size_t row = 1; row <= kRows; ++row) {
+      const std::size_t* const kAbove = &table_[row * kWidth];
+      std::size_t* const current = &table_[(row + 1) * kWidth];
+      const unsigned char kByte = from[row - 1];
+      // The last column of this row where the bytes matched.
+      std::size_t last_column = 0;
+      std::size_t row_minimum = current[1];
+      const std::size_t kFirstColumn = row > limit ? row - limit : 1;
+      const std::size_t kLastColumn =
+          limit < kColumns ? std::min(kColumns, row + limit) : kColumns;
+      for (std::size_t column = kFirstColumn; column <= kLastColumn;
+           ++column) {
+        const auto kOther = static_cast<unsigned char>(to[column - 1]);
+        const std::size_t kSwapRow = last_row_[kOther];
+        const std::size_t kSwapColumn = last_column;
+        std::size_t cost = 1;
+        if (kByte == kOther) {
+          cost = 0;
+          last_column = column;
+        }
+        const std::size_t kTranspose =
+            table_[(kSwapRow * kWidth) + kSwapColumn] + (row - kSwapRow) +
+            (column - kSwapColumn) - 1;
+        const std::size_t kDistance =
+            std::min(std::min(kAbove[column] + cost, current[column] + 1),
+                     std::min(kAbove[column + 1] + 1, kTranspose));
+        current[column + 1] = kDistance;
+        row_minimum = std::min(row_minimum, kDistance);
+      }
+      // The smallest value of a row never decreases from one row to the
+      // next, so once a whole row is above the limit, so is the distance.
+      if (row_minimum > limit) {
+        return limit + 1;
+      }
+      last_row_[kByte] = row;
+    }
+    return std::min(table_[((kRows + 1) * kWidth) + kColumns + 1], limit + 1);
+  }
+
+  std::vector<std::size_t> table_;
+  // The last row of `from` holding each byte value, 0 if none yet.
+  std::array<std::size_t, 256> last_row_{};
+};
+
+}  // namespace
+
+TitleSuggester::TitleSuggester() = default;
+
+TitleSuggester::TitleSuggester(std::vector<std::string> titles)
+    : titles_(std::move(titles)) {
+  std::ranges::sort(titles_);
+  const auto [kFirstDuplicate, kLast] = std::ranges::unique(titles_);
+  titles_.erase(kFirstDuplicate, kLast);
+  if (titles_.empty()) {
+    return;
+  }
+
+  // Each key descends from the root along the edge labelled with its
+  // distance to the node, until it finds no such edge and hangs itself
+  // there. Keys are distinct, so no distance is 0.
+  EditDistance distance;
+  std::vector<std::vector<Edge>> children(titles_.size());
+  for (std::uint32_t title = 1; title < titles_.size(); ++title) {
+    std::uint32_t node = 0;
+    for (;;) {
+      const auto kDistance =
+          static_cast<std::uint32_t>(distance(titles_[title], titles_[node]));
+      const auto kEdge =
+          std::ranges::find(children[node], kDistance, &Edge::distance_);
+      if (kEdge == children[node].end()) {
+        children[node].push_back({.distance_ = kDistance, .target_ = title});
+        break;
+      }
+      node = kEdge->target_;
+    }
+  }
+
+  nodes_.resize(titles_.size());
+  for (std::size_t node = 0; node < titles_.size(); ++node) {
+    std::ranges::sort(children[node], {}, &Edge::distance_);
+    nodes_[node] = {
+        .first_edge_ = static_cast<std::uint32_t>(edges_.size()),
+        .edge_count_ = static_cast<std::uint32_t>(children[node].size())};
+    edges_.insert(edges_.end(), children[node].begin(), children[node].end());
+    longest_title_ = std::max(longest_title_, titles_[node].size());
+  }
+}
+
+auto TitleSuggester::Suggest(std::string_view line) const
+    -> std::vector<std::string> {
+  const std::string_view kTitle = TitleOf(line);
+  const std::size_t kMaxDistance = kTitle.size() <= kShortTitle ? 1 : 2;
+  // Keys are at least as far away as their lengths differ.
+  if (nodes_.empty() || kTitle.empty() ||
+      kTitle.size() > longest_title_ + kMaxDistance) {
+    return {};
+  }
+
+  struct Match {
+    std::size_t distance_;
+    std::uint32_t title_;
+  };
+  std::vector<Match> matches;
+  EditDistance distance;
+  std::vector<std::uint32_t> pending{0};
+  while (!pending.empty()) {
+    const std::uint32_t kNode = pending.back();
+    pending.pop_back();
+    const auto kBegin = edges_.begin() + nodes_[kNode].first_edge_;
+    const auto kEnd = kBegin + nodes_[kNode].edge_count_;
+
+    // By the triangle inequality, a subtree whose keys are d away from this
+    // node can only hold a match if |d - kDistance| <= kMaxDistance. Beyond
+    // the farthest subtree plus kMaxDistance, then, the exact distance no
+    // longer matters; for a leaf, only whether it is a match does.
+    const std::size_t kLimit =
+        (kBegin == kEnd ? 0 : std::prev(kEnd)->distance_) + kMaxDistance;
+    const std::size_t kDistance = distance(kTitle, titles_[kNode], kLimit);
+    if (kDistance <= kMaxDistance) {
+      matches.push_back({.distance_ = kDistance, .title_ = kNode});
+    }
+    const std::size_t kLow =
+        kDistance > kMaxDistance ? kDistance - kMaxDistance : 0;
+    for (auto edge = std::ranges::lower_bound(kBegin, kEnd, kLow, {},
+                                              &Edge::distance_);
+         edge != kEnd && edge->distance_ <= kDistance + kMaxDistance; ++edge) {
+      pending.push_back(edge->target_);
+    }
+  }
+
+  // Titles are sorted, so their indices order equals alphabetically.
+  std::ranges::sort(matches, [](const Match& lhs, const Match& rhs) -> bool {
+    return std::pair(lhs.distance_, lhs.title_) <
+           std::pair(rhs.distance_, rhs.title_);
+  });
+  std::vector<std::string> suggestions;
+  for (const Match& match : matches) {
+    if (suggestions.size() == kMaxSuggestions) {
+      break;
+    }
+    suggestions.push_back(titles_[match.title_]);
+  }
+  return suggestions;
+}
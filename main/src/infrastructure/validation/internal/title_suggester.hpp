@@ -0,0 +1,53 @@
+// validator/internal/title_suggester.hpp
+
+#ifndef VALIDATOR_INTERNAL_TITLE_SUGGESTER_HPP_
+#define VALIDATOR_INTERNAL_TITLE_SUGGESTER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Suggests the mapping keys closest to a title the validator did not
+// recognize, e.g. "bp" for "bpp" or "pb".
+//
+// Closeness is the Damerau-Levenshtein distance over bytes: insertions,
+// deletions, substitutions and transpositions of adjacent bytes each cost
+// one. Since that distance is a metric, the keys are kept in a BK-tree, and
+// a lookup only visits the subtrees the triangle inequality cannot rule out
+// instead of comparing the title with every key. The tree is immutable once
+// built and may be shared between threads.
+class TitleSuggester {
+public:
+  static constexpr std::size_t kMaxSuggestions = 3;
+
+  TitleSuggester();
+  explicit TitleSuggester(std::vector<std::string> titles);
+
+  // At most kMaxSuggestions keys, closest first and alphabetical among
+  // equals. A comment after the title is ignored. Only keys within one edit
+  // of a short title, or two of a longer one, are suggested.
+  [[nodiscard]] auto Suggest(std::string_view line) const
+      -> std::vector<std::string>;
+
+private:
+  // Node i holds titles_[i]. Every key in the subtree below an edge is
+  // exactly distance_ from the edge's parent. The edges of one node are
+  // contiguous and sorted by distance.
+  struct Node {
+    std::uint32_t first_edge_ = 0;
+    std::uint32_t edge_count_ = 0;
+  };
+  struct Edge {
+    std::uint32_t distance_ = 0;
+    std::uint32_t target_ = 0;
+  };
+
+  std::vector<std::string> titles_;
+  std::vector<Node> nodes_;  // nodes_[0] is the root, if there are keys
+  std::vector<Edge> edges_;
+  std::size_t longest_title_ = 0;
+};
+
+#endif // VALIDATOR_INTERNAL_TITLE_SUGGESTER_HPP_
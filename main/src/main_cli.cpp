@@ -8,6 +8,7 @@
 #include "cli/commands/list_exercises_command.hpp"
 #include "cli/commands/query_cycles_command.hpp"
 #include "cli/commands/query_pr_command.hpp"
+#include "cli/commands/remap_command.hpp"
 #include "cli/commands/validate_command.hpp"
 #include "cli/commands/volume_command.hpp"
 #include "cli/framework/application.hpp"
@@ -30,6 +31,7 @@ auto main(int argc, char** argv) -> int {
   app.RegisterCommand(std::make_unique<cli::commands::InsertCommand>());
   app.RegisterCommand(std::make_unique<cli::commands::ExportCommand>());
   app.RegisterCommand(std::make_unique<cli::commands::IngestCommand>());
+  app.RegisterCommand(std::make_unique<cli::commands::RemapCommand>());
   app.RegisterCommand(std::make_unique<cli::commands::ListExercisesCommand>());
   app.RegisterCommand(std::make_unique<cli::commands::QueryCyclesCommand>());
   app.RegisterCommand(std::make_unique<cli::commands::QueryPRCommand>());
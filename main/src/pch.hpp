@@ -16,7 +16,6 @@
 #include <memory>      // 使用次数: 2
 #include <numeric>     // 使用次数: 2
 #include <optional>    // 使用次数: 8
-#include <regex>       // 使用次数: 3
 #include <sstream>     // 使用次数: 4
 #include <stdexcept>   // 使用次数: 2
 #include <string>      // 使用次数: 19
@@ -0,0 +1,162 @@
+// tools/embed_mapping.cpp
+//
+// Build-time generator: turns config/mapping.json into the data that
+// infrastructure/config/embedded_mapping.hpp compiles into the program.
+// Usage: embed_mapping <mapping.json> <output.inc>
+//
+// The file is parsed with cJSON and read by the same rules as
+// ProjectNameMapper::LoadMappings and Validator::LoadRules, so the built-in
+// mapping matches what loading the file at runtime would produce. The
+// output is included inside namespace embedded_mapping and defines:
+//   kMappings - every key whose fullName and type are strings, in file order
+//   kTitles   - every key, as the validator accepts them
+//   kFileData - the file's bytes, to tell an unchanged copy of the file from
+//               an edited one at runtime
+
+#include <cjson/cJSON.h>
+
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kBytesPerLine = 16;
+
+// A std::string_view initializer: a C++ string literal and its length.
+// Control characters become three-digit octal escapes, which cannot swallow
+// the character that follows. With the length spelled out, the compiler need
+// not count the characters itself, which is slow in constant evaluation.
+auto ToStringView(std::string_view text) -> std::string {
+  std::string literal = "{\"";
+  for (const char kChar : text) {
+    const auto kByte = static_cast<unsigned char>(kChar);
+    if (kChar == '"' || kChar == '\\') {
+      literal.push_back('\\');
+      literal.push_back(kChar);
+    } else if (kByte < 0x20 || kByte == 0x7f) {
+      literal.push_back('\\');
+      literal.push_back(static_cast<char>('0' + ((kByte >> 6) & 7)));
+      literal.push_back(static_cast<char>('0' + ((kByte >> 3) & 7)));
+      literal.push_back(static_cast<char>('0' + (kByte & 7)));
+    } else {
+      literal.push_back(kChar);
+    }
+  }
+  literal.append("\", ").append(std::to_string(text.size())).push_back('}');
+  return literal;
+}
+
+auto WriteFileData(std::ostream& out, std::string_view content) -> void {
+  constexpr std::string_view kHexDigits = "0123456789abcdef";
+  out << "inline constexpr std::array<unsigned char, " << content.size()
+      << "> kFileData{{";
+  for (std::size_t i = 0; i < content.size(); ++i) {
+    const auto kByte = static_cast<unsigned char>(content[i]);
+    out << (i % kBytesPerLine == 0 ? "\n    " : " ") << "0x"
+        << kHexDigits[kByte >> 4] << kHexDigits[kByte & 0xf] << ',';
+  }
+  out << "\n}};\n";
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  if (argc != 3) {
+    std::cerr << "Usage: embed_mapping <mapping.json> <output.inc>"
+              << std::endl;
+    return 1;
+  }
+  const std::string kInputPath = argv[1];
+  const std::string kOutputPath = argv[2];
+
+  std::ifstream input(kInputPath, std::ios::binary);
+  const std::string kContent{std::istreambuf_iterator<char>(input),
+                             std::istreambuf_iterator<char>()};
+  if (!input.is_open() || input.bad()) {
+    std::cerr << "Error: [EmbedMapping] Could not read " << kInputPath
+              << std::endl;
+    return 1;
+  }
+
+  cJSON* root = cJSON_Parse(kContent.c_str());
+  if (cJSON_IsObject(root) == 0) {
+    std::cerr << "Error: [EmbedMapping] " << kInputPath
+              << " is not a JSON object." << std::endl;
+    cJSON_Delete(root);
+    return 1;
+  }
+
+  struct Mapping {
+    std::string key_;
+    std::string full_name_;
+    std::string type_;
+  };
+  std::vector<Mapping> mappings;
+  // A repeated key replaces the earlier mapping in place, as it does in
+  // ProjectNameMapper; kMappings must not list a key twice.
+  std::map<std::string, std::size_t, std::less<>> mapping_index;
+  std::ostringstream titles;
+  std::size_t title_count = 0;
+  for (const cJSON* child = root->child; child != nullptr;
+       child = child->next) {
+    if (child->string == nullptr) {
+      continue;
+    }
+    titles << "    " << ToStringView(child->string) << ",\n";
+    ++title_count;
+
+    const cJSON* full_name =
+        cJSON_GetObjectItemCaseSensitive(child, "fullName");
+    const cJSON* type = cJSON_GetObjectItemCaseSensitive(child, "type");
+    if (cJSON_IsString(full_name) == 0 || full_name->valuestring == nullptr ||
+        cJSON_IsString(type) == 0 || type->valuestring == nullptr) {
+      continue;
+    }
+    Mapping mapping{.key_ = child->string,
+                    .full_name_ = full_name->valuestring,
+                    .type_ = type->valuestring};
+    const auto [kIt, kInserted] =
+        mapping_index.try_emplace(mapping.key_, mappings.size());
+    if (kInserted) {
+      mappings.push_back(std::move(mapping));
+    } else {
+      mappings[kIt->second] = std::move(mapping);
+    }
+  }
+  cJSON_Delete(root);
+
+  std::ofstream output(kOutputPath, std::ios::binary | std::ios::trunc);
+  output << "// Generated from " << kInputPath << " by embed_mapping.\n"
+         << "// Do not edit; it is rebuilt whenever the mapping file changes.\n"
+         << "\n"
+         << "inline constexpr std::array<EmbeddedMapping, " << mappings.size()
+         << "> kMappings{{\n";
+  for (const Mapping& mapping : mappings) {
+    output << "    {" << ToStringView(mapping.key_) << ", "
+           << ToStringView(mapping.full_name_) << ", "
+           << ToStringView(mapping.type_) << "},\n";
+  }
+  output << "}};\n"
+         << "\n"
+         << "inline constexpr std::array<std::string_view, " << title_count
+         << "> kTitles{{\n"
+         << titles.str() << "}};\n"
+         << "\n";
+  WriteFileData(output, kContent);
+  output.close();
+  if (!output) {
+    std::cerr << "Error: [EmbedMapping] Could not write " << kOutputPath
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,95 @@
+// tests/bench/log_parser_bench.cpp
+//
+// Times LogParser::ParseFile on a generated log, single-threaded so that
+// the figure is the per-line cost of the parser itself.
+// Usage: log_parser_bench [days]   (default 65000, about 1M lines)
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "infrastructure/converter/log_parser.hpp"
+
+namespace {
+
+constexpr int kDefaultDays = 65000;
+constexpr int kRuns = 5;
+
+// Three exercises a day, three content lines each, with the comments,
+// units and notes a real log has. Returns the number of lines written.
+auto WriteLog(const std::filesystem::path& path, int days) -> std::size_t {
+  constexpr std::string_view kNames[] = {"bp", "bbp", "pu", "sq", "dl"};
+  constexpr std::string_view kWeights[] = {"+60", "+62.5kg", "-20", "+100",
+                                           "+40lbs"};
+  std::mt19937 random(7);
+  auto pick = [&](int count) -> int {
+    return std::uniform_int_distribution<int>(0, count - 1)(random);
+  };
+
+  std::ofstream out(path, std::ios::binary);
+  std::size_t lines = 1;
+  out << "y2025\n";
+  for (int day = 0; day < days; ++day) {
+    char date[8];
+    std::snprintf(date, sizeof(date), "%02d%02d", (day / 28) % 12 + 1,
+                  day % 28 + 1);
+    out << date << '\n';
+    ++lines;
+    if (day % 5 == 0) {
+      out << "r session note\n";
+      ++lines;
+    }
+    for (int project = 0; project < 3; ++project) {
+      out << kNames[pick(5)] << (day % 3 == 0 ? " // cue" : "") << '\n';
+      for (int set_line = 0; set_line < 3; ++set_line) {
+        out << kWeights[pick(5)] << ' ' << 3 + pick(10) << '+'
+            << 3 + pick(10) << '+' << 3 + pick(10)
+            << (day % 4 == 0 ? " # note" : "") << '\n';
+      }
+      lines += 4;
+    }
+    out << '\n';
+    ++lines;
+  }
+  return lines;
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  const int kDays = argc > 1 ? std::stoi(argv[1]) : kDefaultDays;
+  const std::filesystem::path kPath =
+      std::filesystem::temp_directory_path() / "log_parser_bench.txt";
+  const std::size_t kLines = WriteLog(kPath, kDays);
+
+  LogParser parser;
+  parser.SetWorkerCount(1);
+  double best = 0.0;
+  std::size_t parsed_days = 0;
+  for (int run = 0; run < kRuns; ++run) {
+    const auto kStart = std::chrono::steady_clock::now();
+    const ParseResult kResult = parser.ParseFile(kPath.string());
+    const std::chrono::duration<double> kElapsed =
+        std::chrono::steady_clock::now() - kStart;
+    if (!kResult.success_) {
+      std::cerr << "Parse failed:\n" << kResult.diagnostics_;
+      return 1;
+    }
+    parsed_days = kResult.log_.Days().size();
+    best = run == 0 ? kElapsed.count() : std::min(best, kElapsed.count());
+  }
+  std::filesystem::remove(kPath);
+
+  std::cout << kLines << " lines, " << parsed_days << " days: best of "
+            << kRuns << " " << best << " s, "
+            << static_cast<double>(kLines) / best / 1e6 << " M lines/s"
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,131 @@
+// tests/ingest_sources_test.cpp
+//
+// Incremental ingest of several append-only logs into one database. Two
+// logs that start on the same day share a cycle_id, so a resumed or
+// restarted ingest of one must find its own rows by source and leave the
+// other's alone.
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "application/action_handler.hpp"
+#include "sqlite3.h"
+#include "test_support.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+auto WriteFile(const fs::path& path, std::string_view text,
+               bool append = false) -> void {
+  std::ofstream out(path, append ? std::ios::binary | std::ios::app
+                                 : std::ios::binary | std::ios::trunc);
+  out << text;
+}
+
+auto Ingest(const fs::path& work_dir, const fs::path& log) -> bool {
+  AppConfig config{};
+  config.action_ = ActionType::Ingest;
+  config.log_filepath_ = log.string();
+  // No mapping file: the built-in mapping applies.
+  config.mapping_path_ = (work_dir / "config" / "mapping.json").string();
+  config.base_path_ = work_dir.string();
+  return ActionHandler::Run(config) == AppExitCode::kSuccess;
+}
+
+// Every row of `sql`, its columns joined by '|'.
+auto Rows(sqlite3* db, const char* sql) -> std::vector<std::string> {
+  std::vector<std::string> rows;
+  sqlite3_stmt* stmt = nullptr;
+  if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+    CHECK(!"statement prepares");
+    return rows;
+  }
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    std::string row;
+    for (int column = 0; column < sqlite3_column_count(stmt); ++column) {
+      const unsigned char* text = sqlite3_column_text(stmt, column);
+      row += column == 0 ? "" : "|";
+      row += text == nullptr ? "NULL" : reinterpret_cast<const char*>(text);
+    }
+    rows.push_back(std::move(row));
+  }
+  sqlite3_finalize(stmt);
+  return rows;
+}
+
+// One source's rows: exercise code, date, total_days and the reps of its
+// sets, ordered by id.
+auto SourceRows(sqlite3* db, std::string_view log_name)
+    -> std::vector<std::string> {
+  const std::string kSql =
+      "SELECT l.exercise_code, l.date - l.cycle_id, l.total_days, "
+      "  (SELECT group_concat(s.reps) FROM training_sets AS s "
+      "   WHERE s.log_id = l.id) "
+      "FROM training_logs AS l JOIN ingest_sources AS src "
+      "  ON src.id = l.source_id "
+      "WHERE src.source LIKE '%" +
+      std::string(log_name) + "' ORDER BY l.id;";
+  return Rows(db, kSql.c_str());
+}
+
+}  // namespace
+
+auto main() -> int {
+  const fs::path kWorkDir =
+      fs::temp_directory_path() / "workout_ingest_sources_test";
+  fs::remove_all(kWorkDir);
+  fs::create_directories(kWorkDir);
+  const fs::path kLogA = kWorkDir / "a.txt";
+  const fs::path kLogB = kWorkDir / "b.txt";
+
+  // Both logs start on 0101.
+  WriteFile(kLogA, "y2025\n0101\nbp\n+60 8\n0102\nbp\n+60 9\n");
+  WriteFile(kLogB, "y2025\n0101\nsq\n+100 5\n0102\nsq\n+100 6\n");
+  CHECK(Ingest(kWorkDir, kLogA));
+  CHECK(Ingest(kWorkDir, kLogB));
+
+  // a.txt grows after b.txt was stored: the resume re-reads a's last day.
+  WriteFile(kLogA, "0103\nbp\n+62 7\n", true);
+  CHECK(Ingest(kWorkDir, kLogA));
+
+  sqlite3* db = nullptr;
+  const fs::path kDbPath = kWorkDir / "output" / "db" / "workout_logs.sqlite3";
+  CHECK(sqlite3_open(kDbPath.string().c_str(), &db) == SQLITE_OK);
+
+  CHECK(SourceRows(db, "a.txt") ==
+        std::vector<std::string>({"bp|0|3|8", "bp|1|3|9", "bp|2|3|7"}));
+  CHECK(SourceRows(db, "b.txt") ==
+        std::vector<std::string>({"sq|0|2|5", "sq|1|2|6"}));
+
+  // b.txt's checkpoint still points at its own rows: growing it resumes
+  // cleanly without touching a.txt.
+  WriteFile(kLogB, "0104\nsq\n+100 4\n", true);
+  CHECK(Ingest(kWorkDir, kLogB));
+  CHECK(SourceRows(db, "b.txt") ==
+        std::vector<std::string>({"sq|0|3|5", "sq|1|3|6", "sq|3|3|4"}));
+  CHECK(SourceRows(db, "a.txt").size() == 3);
+
+  // An edit before a.txt's checkpoint replaces all of a.txt's rows, and
+  // only those.
+  WriteFile(kLogA, "y2025\n0101\nbp\n+61 8\n");
+  CHECK(Ingest(kWorkDir, kLogA));
+  CHECK(SourceRows(db, "a.txt") == std::vector<std::string>({"bp|0|1|8"}));
+  CHECK(SourceRows(db, "b.txt").size() == 3);
+
+  CHECK(Rows(db, "SELECT COUNT(*) FROM training_logs;") ==
+        std::vector<std::string>({"4"}));
+  CHECK(Rows(db, "SELECT COUNT(*) FROM training_sets WHERE log_id NOT IN "
+                 "(SELECT id FROM training_logs);") ==
+        std::vector<std::string>({"0"}));
+  CHECK(Rows(db, "SELECT code FROM exercise_mappings ORDER BY code;") ==
+        std::vector<std::string>({"bp", "sq"}));
+
+  sqlite3_close(db);
+  fs::remove_all(kWorkDir);
+  return test_support::Finish();
+}
@@ -0,0 +1,113 @@
+// tests/line_grammar_test.cpp
+//
+// Each line_grammar automaton against the ECMAScript regex it replaced.
+// Lines come from two sources: every string of up to three bytes over a
+// small alphabet, and random concatenations of pieces that steer the
+// regexes deep into their grammar (signs, weights, units, reps, comment
+// delimiters, whitespace and line breaks).
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+
+#include "infrastructure/validation/internal/line_grammar.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+constexpr int kReportedMismatches = 10;
+
+// Lines of `grammar_name` on which the automaton and the regex disagree.
+struct Differential {
+  std::string_view grammar_name;
+  std::regex regex;
+  int mismatches = 0;
+
+  template <typename Grammar>
+  auto Compare(const std::string& line) -> void {
+    if (line_grammar::MatchesLine<Grammar>(line) ==
+        std::regex_match(line, regex)) {
+      return;
+    }
+    if (++mismatches <= kReportedMismatches) {
+      std::cerr << grammar_name << " disagrees with its regex on \"" << line
+                << "\"" << std::endl;
+    }
+  }
+};
+
+// Every string of 0 to 3 bytes over `alphabet`.
+template <typename Visit>
+auto ForEachShortLine(std::string_view alphabet, Visit visit) -> void {
+  visit(std::string());
+  for (char first : alphabet) {
+    visit(std::string{first});
+    for (char second : alphabet) {
+      visit(std::string{first, second});
+      for (char third : alphabet) {
+        visit(std::string{first, second, third});
+      }
+    }
+  }
+}
+
+}  // namespace
+
+auto main() -> int {
+  Differential year{"YearLine", std::regex(R"(^y\d{4}$)")};
+  Differential date{"DateLine", std::regex(R"(^\d{4}$)")};
+  Differential note{"NoteLine", std::regex(R"(^r\s+.+$)")};
+  Differential content{
+      "ContentLine",
+      std::regex(R"(^[+-]\s*\d+(\.\d+)?(lbs|kg|LBS|KG)?\s+\d+(\s*\+\s*\d+)*)"
+                 R"((\s*(?://|#|;).*)?$)")};
+
+  auto compare_all = [&](const std::string& line) -> void {
+    year.Compare<line_grammar::YearLine>(line);
+    date.Compare<line_grammar::DateLine>(line);
+    note.Compare<line_grammar::NoteLine>(line);
+    content.Compare<line_grammar::ContentLine>(line);
+  };
+
+  using namespace std::string_view_literals;
+  ForEachShortLine("y0r+-. lkgLKG/#;\t\r\n\v\fx\xff\0"sv, compare_all);
+
+  // Pieces of valid lines of every grammar, and bytes that break them.
+  constexpr std::string_view kPieces[] = {
+      "y",   "r",  "+",   "-",  "0",  "2025", "60", "5",  ".",  ".5",
+      "l",   "lb", "lbs", "k",  "kg", "LBS",  "KG", "Kg", " ", "  ",
+      "\t",  "\v", "\f",  "\r", "\n", "\r\n", "/",  "//", "#",  ";",
+      "x",   "note"};
+  constexpr int kCases = 300000;
+  constexpr int kMaxPieces = 10;
+  std::mt19937 random(18);
+  std::uniform_int_distribution<std::size_t> pick(0, std::size(kPieces) - 1);
+  std::uniform_int_distribution<int> length(1, kMaxPieces);
+  // Half the lines open like one of the grammars so that most of the rest
+  // is not rejected at the first byte.
+  constexpr std::string_view kOpenings[] = {"y", "r ", "+", "-"};
+  std::uniform_int_distribution<std::size_t> pick_opening(
+      0, 2 * std::size(kOpenings) - 1);
+  for (int i = 0; i < kCases; ++i) {
+    std::string line;
+    if (const std::size_t kOpening = pick_opening(random);
+        kOpening < std::size(kOpenings)) {
+      line = kOpenings[kOpening];
+    }
+    for (int pieces = length(random); pieces > 0; --pieces) {
+      line += kPieces[pick(random)];
+    }
+    compare_all(line);
+  }
+
+  CHECK(year.mismatches == 0);
+  CHECK(date.mismatches == 0);
+  CHECK(note.mismatches == 0);
+  CHECK(content.mismatches == 0);
+
+  return test_support::Finish();
+}
@@ -0,0 +1,45 @@
+// tests/test_support.hpp
+//
+// What the tests share. Each test is a plain executable run by ctest: it
+// reports every failed CHECK on stderr and exits non-zero if there was one.
+
+#ifndef TESTS_TEST_SUPPORT_HPP_
+#define TESTS_TEST_SUPPORT_HPP_
+
+#include <iostream>
+#include <source_location>
+#include <string_view>
+
+namespace test_support {
+
+inline auto FailureCount() -> int& {
+  static int count = 0;
+  return count;
+}
+
+// Records a failed check and where it is; returns `passed`.
+inline auto Check(bool passed, std::string_view expression,
+                  std::source_location where = std::source_location::current())
+    -> bool {
+  if (!passed) {
+    ++FailureCount();
+    std::cerr << where.file_name() << ":" << where.line()
+              << ": check failed: " << expression << std::endl;
+  }
+  return passed;
+}
+
+// The exit code for main(): 0 if every check passed.
+inline auto Finish() -> int {
+  if (FailureCount() != 0) {
+    std::cerr << FailureCount() << " check(s) failed." << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace test_support
+
+#define CHECK(expression) ::test_support::Check((expression), #expression)
+
+#endif // TESTS_TEST_SUPPORT_HPP_
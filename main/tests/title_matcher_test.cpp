@@ -0,0 +1,83 @@
+// tests/title_matcher_test.cpp
+//
+// TitleMatcher against the key alternation regex it replaced,
+// ^(key1|key2|...)(\s*(?://|#|;).*)?$, on fixed cases and on generated
+// lines built from pieces of the keys, delimiters and line breaks.
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "infrastructure/validation/internal/title_matcher.hpp"
+#include "test_support.hpp"
+
+namespace {
+
+// The regex the validator used to build from the mapping keys. The keys
+// below contain no regex metacharacters, so it takes them literally too.
+auto TitleRegex(const std::vector<std::string>& titles) -> std::regex {
+  std::string pattern = "^(";
+  for (std::size_t i = 0; i < titles.size(); ++i) {
+    pattern += (i == 0 ? "" : "|") + titles[i];
+  }
+  pattern += R"()(\s*(?://|#|;).*)?$)";
+  return std::regex(pattern);
+}
+
+}  // namespace
+
+auto main() -> int {
+  const std::vector<std::string> kTitles = {"bp", "bpx", "bbp", "sq", "dl",
+                                            "pu", "ohp"};
+  const TitleMatcher kMatcher(kTitles);
+  const std::regex kRegex = TitleRegex(kTitles);
+
+  CHECK(kMatcher.Matches("bp"));
+  CHECK(kMatcher.Matches("bpx"));
+  CHECK(kMatcher.Matches("bp // easy"));
+  CHECK(kMatcher.Matches("bp#easy"));
+  CHECK(kMatcher.Matches("bp ; x"));
+  CHECK(kMatcher.Matches("bp \t// \t"));
+  CHECK(kMatcher.Matches("bp \r// x"));
+  CHECK(!kMatcher.Matches("b"));
+  CHECK(!kMatcher.Matches("bpy"));
+  CHECK(!kMatcher.Matches("bp "));
+  CHECK(!kMatcher.Matches("bp\r"));
+  CHECK(!kMatcher.Matches("bp / x"));
+  CHECK(!kMatcher.Matches("xbp"));
+  // The comment ends at a line break, as '.' does in the regex.
+  CHECK(!kMatcher.Matches("bp // easy\r"));
+  CHECK(!kMatcher.Matches("bp // ea\rsy"));
+  CHECK(!kMatcher.Matches("bp #\n"));
+  CHECK(!kMatcher.Matches("bp;\r"));
+
+  // Differential: short lines over the bytes that matter to either side.
+  constexpr std::string_view kPieces[] = {
+      "b", "p", "x", "bp", "sq", "ohp", " ", "\t", "\r", "\n", "/", "//",
+      "#", ";", "y", "\v"};
+  constexpr int kCases = 200000;
+  constexpr int kMaxPieces = 6;
+  std::mt19937 random(17);
+  std::uniform_int_distribution<std::size_t> pick(0, std::size(kPieces) - 1);
+  std::uniform_int_distribution<int> length(1, kMaxPieces);
+  int mismatches = 0;
+  for (int i = 0; i < kCases; ++i) {
+    std::string line;
+    for (int pieces = length(random); pieces > 0; --pieces) {
+      line += kPieces[pick(random)];
+    }
+    if (kMatcher.Matches(line) != std::regex_match(line, kRegex) &&
+        ++mismatches <= 10) {
+      CHECK(!"TitleMatcher and the regex disagree");
+      std::cerr << "  line: \"" << line << "\"" << std::endl;
+    }
+  }
+  CHECK(mismatches == 0);
+
+  return test_support::Finish();
+}
@@ -0,0 +1,212 @@
+// tests/zero_copy_test.cpp
+//
+// The parsed tree is built in place and only ever moved: no path copies a
+// day, project or set run. A copy allocates, so the test counts calls to
+// the global operator new (which the arenas' upstream resource also goes
+// through) and checks that the count does not grow with the number of sets.
+// The arenas themselves grow geometrically, which allows a few more blocks
+// for a larger log; one copy per day or project would add hundreds.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "common/json_reader.hpp"
+#include "domain/models/workout_log.hpp"
+#include "infrastructure/converter/converter.hpp"
+#include "infrastructure/converter/log_parser.hpp"
+#include "infrastructure/converter/project_name_mapper.hpp"
+#include "infrastructure/persistence/inserter/data_inserter.hpp"
+#include "infrastructure/persistence/manager/db_manager.hpp"
+#include "infrastructure/serializer/serializer.hpp"
+#include "infrastructure/validation/validator.hpp"
+#include "sqlite3.h"
+#include "test_support.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::atomic<long> g_allocations{0};
+
+auto Allocate(std::size_t size, std::size_t alignment) -> void* {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  // aligned_alloc wants a multiple of the alignment.
+  const std::size_t kSize =
+      size == 0 ? alignment : (size + alignment - 1) / alignment * alignment;
+  void* memory = std::aligned_alloc(alignment, kSize);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+}  // namespace
+
+auto operator new(std::size_t size) -> void* {
+  return Allocate(size, alignof(std::max_align_t));
+}
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+  return Allocate(size, static_cast<std::size_t>(alignment));
+}
+auto operator delete(void* memory) noexcept -> void { std::free(memory); }
+auto operator delete(void* memory, std::size_t /*size*/) noexcept -> void {
+  std::free(memory);
+}
+auto operator delete(void* memory, std::align_val_t /*alignment*/) noexcept
+    -> void {
+  std::free(memory);
+}
+auto operator delete(void* memory, std::size_t /*size*/,
+                     std::align_val_t /*alignment*/) noexcept -> void {
+  std::free(memory);
+}
+
+namespace {
+
+// A larger log may take a few more arena blocks and vector regrowths.
+constexpr long kGeometricSlack = 16;
+
+struct LogShape {
+  int days;
+  int sets_per_project;
+};
+
+constexpr const char* kTitles[] = {"bp", "sq", "dl"};
+
+// Every set gets its own weight so that no two merge into one run.
+auto WriteLog(const fs::path& path, LogShape shape) -> void {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << "y2025\n";
+  for (int day = 0; day < shape.days; ++day) {
+    const int kMonth = (day / 28) + 1;
+    const int kDay = (day % 28) + 1;
+    out << kMonth / 10 << kMonth % 10 << kDay / 10 << kDay % 10 << "\n";
+    for (const char* title : kTitles) {
+      out << title << "\n";
+      for (int set = 0; set < shape.sets_per_project; ++set) {
+        out << "+" << 20 + set << " " << 1 + (set % 9) << "\n";
+      }
+    }
+  }
+}
+
+auto CountSets(const WorkoutLog& log) -> std::size_t {
+  std::size_t sets = 0;
+  for (const DailyData& day : log.Days()) {
+    for (const ProjectData& project : day.projects_) {
+      sets += project.SetCount();
+    }
+  }
+  return sets;
+}
+
+auto ExpectedSets(LogShape shape) -> std::size_t {
+  return static_cast<std::size_t>(shape.days) * std::size(kTitles) *
+         static_cast<std::size_t>(shape.sets_per_project);
+}
+
+// Allocations made by each path for one log of the given shape.
+struct PathAllocations {
+  long convert = 0;
+  long deserialize_and_insert = 0;
+  long append = 0;
+};
+
+auto Measure(const fs::path& work_dir, LogShape shape) -> PathAllocations {
+  PathAllocations counts;
+  const fs::path kLogPath = work_dir / "log.txt";
+  const fs::path kJsonPath = work_dir / "log.json";
+  const fs::path kDbPath = work_dir / "workout_logs.sqlite3";
+  WriteLog(kLogPath, shape);
+
+  LogParser parser;
+  Converter converter(parser);
+  auto mapper = std::make_shared<ProjectNameMapper>();
+  mapper->UseEmbeddedMappings();
+  converter.Configure(mapper);
+  ValidationPass validation(
+      Validator::BuildRules({std::begin(kTitles), std::end(kTitles)}));
+
+  // Convert: text -> WorkoutLog.
+  long before = g_allocations.load();
+  std::optional<WorkoutLog> converted =
+      converter.Convert(kLogPath.string(), validation);
+  counts.convert = g_allocations.load() - before;
+  if (!CHECK(converted.has_value())) {
+    return counts;
+  }
+  CHECK(CountSets(*converted) == ExpectedSets(shape));
+
+  // Insert: JSON file -> WorkoutLog -> database.
+  std::ofstream(kJsonPath, std::ios::binary | std::ios::trunc)
+      << Serializer::Serialize(*converted);
+  std::optional<CJsonPtr> json = JsonReader::ReadFile(kJsonPath.string());
+  if (!CHECK(json.has_value())) {
+    return counts;
+  }
+  fs::remove(kDbPath);
+  DbManager db_manager(kDbPath.string());
+  CHECK(db_manager.Open());
+  sqlite3* db = db_manager.GetConnection();
+  DataInserter inserter(db);
+  // One transaction, as DbFacade uses, instead of a sync per row.
+  CHECK(sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr) == SQLITE_OK);
+
+  before = g_allocations.load();
+  WorkoutLog deserialized = Serializer::Deserialize(json->get());
+  CHECK(inserter.Insert(deserialized));
+  counts.deserialize_and_insert = g_allocations.load() - before;
+  CHECK(sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) == SQLITE_OK);
+  CHECK(CountSets(deserialized) == ExpectedSets(shape));
+
+  // Append moves days between logs with different arenas; the days must
+  // keep their own arena rather than be copied into the target's.
+  WorkoutLog target;
+  target.AddDay();
+  before = g_allocations.load();
+  target.Append(std::move(deserialized));
+  counts.append = g_allocations.load() - before;
+  CHECK(CountSets(target) == ExpectedSets(shape));
+
+  return counts;
+}
+
+}  // namespace
+
+auto main() -> int {
+  const fs::path kWorkDir =
+      fs::temp_directory_path() / "workout_zero_copy_test";
+  fs::remove_all(kWorkDir);
+  fs::create_directories(kWorkDir);
+
+  // 64 times the sets: 8 times the days, each project 8 times longer.
+  const PathAllocations kSmall = Measure(kWorkDir, {.days = 40,
+                                                    .sets_per_project = 4});
+  const PathAllocations kLarge = Measure(kWorkDir, {.days = 320,
+                                                    .sets_per_project = 32});
+
+  CHECK(kLarge.convert <= kSmall.convert + kGeometricSlack);
+  CHECK(kLarge.deserialize_and_insert <=
+        kSmall.deserialize_and_insert + kGeometricSlack);
+  // Only the day and arena lists and the symbol remap, whatever the size.
+  CHECK(kLarge.append == kSmall.append);
+  if (test_support::FailureCount() != 0) {
+    std::cerr << "allocations (small -> large): convert " << kSmall.convert
+              << " -> " << kLarge.convert << ", deserialize+insert "
+              << kSmall.deserialize_and_insert << " -> "
+              << kLarge.deserialize_and_insert << ", append " << kSmall.append
+              << " -> " << kLarge.append << std::endl;
+  }
+
+  fs::remove_all(kWorkDir);
+  return test_support::Finish();
+}